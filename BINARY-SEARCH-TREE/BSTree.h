@@ -3,8 +3,8 @@
 //  Laboratory 9                                    BSTree.h
 //
 //  Class declarations for the linked implementation of the Binary
-//  Search Tree ADT -- including the recursive helpers of the
-//  public member functions
+//  Search Tree ADT -- including the helpers of the public member
+//  functions
 //
 //--------------------------------------------------------------------
 
@@ -13,28 +13,266 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <vector>
+#include <iterator>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "ExternalSort.h"
 
 using namespace std;
 
-template < typename DataType, class KeyType >    // DataType : tree data item
-class BSTree                                     // KeyType : key field
+//--------------------------------------------------------------------
+//
+// Balancing policies for the Balance parameter of BSTree.  A policy
+// gives every node a NodeData base holding its balancing information,
+// and rebalance() is called on each node of an insert or remove path,
+// bottom up, after the node's subtrees have been changed.
+//
+
+// Plain binary search tree: nodes carry nothing extra and are never
+// moved.  Keys inserted in sorted order build a tree as tall as it has
+// nodes.
+class Unbalanced
+{
+  public:
+    class NodeData { };
+
+    static const bool REBALANCES = false;
+
+    template < class Node >
+    static void rebalance ( Node*& ) { }
+};
+
+// AVL tree: every node keeps the height of its subtree, and rotations
+// keep the heights of the two subtrees of any node within one of each
+// other.  The tree height stays below 1.44 log2(n + 2).  Rotations also
+// fix the subtree sizes that every BSTree node keeps.
+class AVLBalanced
+{
+  public:
+    class NodeData
+    {
+      public:
+        NodeData () : height( 1 ) { }
+
+        int height;            // Height of the subtree at this node
+    };
+
+    static const bool REBALANCES = true;
+
+    template < class Node >
+    static void rebalance ( Node*& source );
+
+  private:
+    template < class Node >
+    static int heightOf ( Node* source );
+    template < class Node >
+    static void updateHeight ( Node* source );
+    template < class Node >
+    static void rotateLeft ( Node*& source );
+    template < class Node >
+    static void rotateRight ( Node*& source );
+};
+
+//--------------------------------------------------------------------
+//
+// Node allocators for the Allocator parameter of BSTree.  An allocator
+// hands out uninitialised memory for one Node at a time and takes it
+// back.  If RELEASES_ALL is true, release() frees the memory of every
+// node at once, and a tree whose nodes need no destructor is cleared by
+// calling it instead of visiting the nodes.
+//
+
+// Slab allocator: nodes are carved out of blocks that double in size,
+// from FIRST_BLOCK up to MAX_BLOCK nodes, and removed nodes are kept on
+// a free list for the next insert.  Each tree owns its own pool.
+template < typename Node >
+class NodePool
+{
+  public:
+    static const bool RELEASES_ALL = true;
+    static const int FIRST_BLOCK = 16;
+    static const int MAX_BLOCK = 4096;
+
+    NodePool ();
+    NodePool ( NodePool&& other );       // Takes other's blocks
+    NodePool& operator= ( NodePool&& other );
+    ~NodePool ();
+
+    void* allocate ();                   // Memory for one node
+    void deallocate ( Node* node );      // Node already destroyed
+    void reserve ( int count );          // Room for count more nodes
+                                         //   in one block
+    void release ();                     // Free every block
+
+  private:
+    NodePool ( const NodePool& );        // Not copyable
+    NodePool& operator= ( const NodePool& );
+
+    void addBlock ( int count );
+
+    // Bytes per node, rounded up so that every node is aligned
+    static const size_t SLOT_BYTES =
+        ( sizeof( Node ) + alignof( Node ) - 1 ) / alignof( Node ) * alignof( Node );
+
+    struct FreeSlot { FreeSlot* next; };
+
+    vector<char*> blocks;                // Every block allocated
+    char* unused;                        // Next slot never handed out
+    char* blockEnd;                      // End of the newest block
+    FreeSlot* freeSlots;                 // Slots of removed nodes
+    int nextBlock;                       // Nodes in the next block
+};
+
+// Every node is allocated and freed on its own with new and delete, as
+// BSTree did before it had an Allocator parameter.
+template < typename Node >
+class HeapNodes
+{
+  public:
+    static const bool RELEASES_ALL = false;
+
+    void* allocate () { return ::operator new( sizeof( Node ) ); }
+    void deallocate ( Node* node ) { ::operator delete( node ); }
+    void reserve ( int ) { }
+    void release () { }
+};
+
+//--------------------------------------------------------------------
+//
+// Instrumentation policies for the Instrument parameter of BSTree.  The
+// tree derives from its policy, and every retrieve, find, insert and
+// remove makes an Instrument::Probe on it.  The probe is told of each
+// node the operation goes down through and each key comparison it makes,
+// and passes its counts to the policy when the operation ends.
+//
+
+// No instrumentation.  The probe is empty and its calls do nothing, so
+// they compile away, and as an empty base the policy adds no bytes to
+// the tree.
+class NoStats
+{
+  public:
+    class Probe
+    {
+      public:
+        Probe ( const NoStats&, int ) { }
+
+        void visit () { }                // A node on the search path
+        void compare () { }              // A key comparison
+    };
+};
+
+// Keeps, for each kind of operation, histograms of the nodes visited,
+// which is the depth the search reached, and of the key comparisons
+// made.  Counting makes retrieve write to the tree, so threads sharing
+// a counted tree must lock it even to read.
+class CountingStats
+{
+  public:
+    enum Operation { RETRIEVE, INSERT, REMOVE, OPERATIONS };
+
+    static const int BUCKETS = 64;       // Buckets per histogram
+
+    class Histogram
+    {
+      public:
+        Histogram ();
+
+        void add ( int value );
+        long getCount ( int bucket ) const;   // Values equal to bucket; the
+                                              //   last bucket also counts
+                                              //   every larger value
+        long getTotal () const;               // Number of values added
+        double getMean () const;
+        int getMax () const;                  // Largest value added
+
+      private:
+        long counts[ BUCKETS ];
+        long total;
+        long sum;
+        int max;
+    };
+
+    class Probe
+    {
+      public:
+        Probe ( const CountingStats& stats, int operation );
+        ~Probe ();                       // Adds the counts to stats
+
+        void visit () { visited++; }
+        void compare () { comparisons++; }
+
+      private:
+        const CountingStats& stats;
+        int operation;
+        int visited;
+        int comparisons;
+    };
+
+    const Histogram& getDepths ( Operation operation ) const;
+    const Histogram& getComparisons ( Operation operation ) const;
+    void resetStats ();
+    void showStats () const;             // Output the histograms -- used
+                                         //   in testing/debugging
+
+  private:
+    mutable Histogram depths[ OPERATIONS ];
+    mutable Histogram comparisons[ OPERATIONS ];
+};
+
+//--------------------------------------------------------------------
+
+template < typename DataType, class KeyType,     // DataType : tree data item
+           class Balance = Unbalanced,           // KeyType : key field
+           template < typename > class Allocator // Balance : policy above
+               = NodePool,                       // Allocator : as above
+           class Instrument = NoStats >          // Instrument : as above
+class BSTree
+  : private Instrument
 {
   public:
 
     // Constructor
     BSTree ();                         // Default constructor
-    BSTree ( const BSTree<DataType,KeyType>& other );   // Copy constructor
-    BSTree& operator= ( const BSTree<DataType,KeyType>& other );
+    BSTree ( const BSTree<DataType,KeyType,Balance,Allocator,Instrument>& other );   // Copy constructor
+    BSTree& operator= ( const BSTree<DataType,KeyType,Balance,Allocator,Instrument>& other );
 						  // Overloaded assignment operator
+    BSTree ( BSTree<DataType,KeyType,Balance,Allocator,Instrument>&& other );   // Move constructor
+    BSTree& operator= ( BSTree<DataType,KeyType,Balance,Allocator,Instrument>&& other );
+						  // Move assignment operator
 
     // Destructor
     ~BSTree ();
 
     // Binary search tree manipulation operations
     void insert ( const DataType& newDataItem );  // Insert data item
+    void insert ( DataType&& newDataItem );       // Insert by moving
+    template < typename... Args >
+    void emplace ( Args&&... args );              // Insert DataType(args...)
+
+    // Replace the contents with a perfectly balanced tree of the items in
+    // [first, last).  buildFromSorted needs strictly ascending keys and
+    // compares none of them; buildFromUnsorted sorts the items first,
+    // keeping the last of any with the same key, in runs of runItems
+    // that go to temporary files when there is more than one, so it
+    // needs a trivially copyable DataType.  It returns false, leaving
+    // the tree empty, if a run file fails.
+    template < typename ForwardIterator >
+    void buildFromSorted ( ForwardIterator first, ForwardIterator last );
+    template < typename InputIterator >
+    bool buildFromUnsorted ( InputIterator first, InputIterator last,
+            int runItems = ExternalSort<DataType>::DEFAULT_RUN_ITEMS );
+
     bool retrieve ( const KeyType& searchKey, DataType& searchDataItem ) const;
                                                   // Retrieve data item
     bool remove ( const KeyType& deleteKey );            // Remove data item
+    bool remove ( const KeyType& deleteKey, DataType& removedDataItem );
+                                                  // Remove and move out
+    const DataType* find ( const KeyType& searchKey ) const;
+                                                  // NULL if not found
     void writeKeys () const;                      // Output keys
     void clear ();                                // Clear tree
 
@@ -50,35 +288,111 @@ class BSTree                                     // KeyType : key field
     int getCount () const;			  // Number of nodes in tree
     void writeLessThan ( const KeyType& searchKey ) const; // Output keys < searchKey
 
+    // Order statistics, in time proportional to the height
+    bool select ( int position, DataType& searchDataItem ) const;
+                                                  // Item with position
+                                                  //   smaller keys
+    int rank ( const KeyType& searchKey ) const;  // Number of keys
+                                                  //   < searchKey
+
+    // The instrumentation policy, for reading its counts.  Copying or
+    // moving a tree does not copy its counts.
+    const Instrument& getStats () const;
+
+    // In-order iteration, in ascending key order.  Any insert, remove or
+    // clear invalidates the iterators.
+    class const_iterator;
+    const_iterator begin () const;
+    const_iterator end () const;
+    const_iterator lowerBound ( const KeyType& searchKey ) const;
+                                                  // First key >= searchKey
+    const_iterator upperBound ( const KeyType& searchKey ) const;
+                                                  // First key > searchKey
+
+    // Calls visit(item) on the items with lowKey <= key <= highKey in
+    // ascending order, until visit returns false.  Returns the number of
+    // items visited.
+    template < typename Function >
+    int forEachInRange ( const KeyType& lowKey, const KeyType& highKey,
+                         Function visit ) const;
+
   protected:
 
     class BSTreeNode                  // Inner class: facilitator for the BSTree class
+      : public Balance::NodeData
     {
       public:
     
         // Constructor
         BSTreeNode ( const DataType &nodeDataItem, BSTreeNode *leftPtr, BSTreeNode *rightPtr );
+        BSTreeNode ( DataType &&nodeDataItem, BSTreeNode *leftPtr, BSTreeNode *rightPtr );
+
+        // Number of nodes in the subtree at source, zero if it is empty
+        static int sizeOf ( const BSTreeNode *source );
 
         // Data members
         DataType dataItem;         // Binary search tree data item
         BSTreeNode *left,    // Pointer to the left child
                    *right;   // Pointer to the right child
+        int size;            // Nodes in the subtree at this node
     };
 
-    // Recursive helpers for the public member functions -- insert
-    // prototypes of these functions here.
+    // Helpers for the public member functions.  Apart from showHelper
+    // they are loops rather than recursive, so a tree built from sorted
+    // keys, which is as tall as it has nodes, cannot overflow the stack.
     void showHelper      ( BSTreeNode *p, int level ) const;
     void copyHelper( BSTreeNode* &, BSTreeNode* );
-    void insertHelper( BSTreeNode* &, const DataType & );
-    bool retrieveHelper( BSTreeNode* , const KeyType &, DataType & ) const;
-    bool removeHelper( BSTreeNode* &, const KeyType & );
+    template < typename Item >
+    void insertHelper( BSTreeNode* &, Item && );
+    bool removeHelper( BSTreeNode* &, const KeyType &, DataType* );
     void writeKeysHelper( BSTreeNode* ) const;
     void clearHelper( BSTreeNode* &source );
-    void countHelper( BSTreeNode* , int & ) const;
     int heightHelper( BSTreeNode* ) const;
+    template < typename Source >
+    void buildHelper( Source next, int count );
+    template < typename Item >
+    BSTreeNode* createNode( Item && );
+    void destroyNode( BSTreeNode* );
+    void rebalancePath( vector<BSTreeNode**>& path );
+    void resizePath( BSTreeNode* , const KeyType &, int,
+                     typename Instrument::Probe & );
+    template < typename Visitor >
+    void inorderHelper( BSTreeNode* source, Visitor visit ) const;
 
-    // Data member
+    // Data members
     BSTreeNode *root;   // Pointer to the root node
+    Allocator<BSTreeNode> nodes;   // Memory for the nodes
+
+  public:
+
+    class const_iterator
+    {
+      public:
+        typedef forward_iterator_tag iterator_category;
+        typedef DataType value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const DataType* pointer;
+        typedef const DataType& reference;
+
+        const_iterator ();
+
+        reference operator* () const;
+        pointer operator-> () const;
+        const_iterator& operator++ ();
+        const_iterator operator++ ( int );
+        bool operator== ( const const_iterator& other ) const;
+        bool operator!= ( const const_iterator& other ) const;
+
+      private:
+        friend class BSTree;
+
+        const_iterator ( BSTreeNode* source );
+        void pushLeft ( BSTreeNode* source );
+
+        vector<BSTreeNode*> path;  // Current node on top, below it the
+                                   //   ancestors whose items are still
+                                   //   to come; empty at the end
+    };
 };
 
 #endif	// define BSTREE_H
@@ -0,0 +1,651 @@
+/**
+ * @file BTreeIndex.cpp
+ * @author Amardeep Singh
+ * @brief This program builds a static B+-tree index over int keys and
+ * searches it.
+*/
+#include "BTreeIndex.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+template< typename DataType >
+const char BTreeIndex< DataType >::MAGIC[8] = { 'B', 'T', 'I', 'N', 'D', '0', '1', '\n' };
+
+/**
+ * Default constructor.
+ * 
+ * The default constructor creates an empty index.
+ * 
+ * @post The index is empty.
+ * 
+ */
+template< typename DataType >
+BTreeIndex< DataType >::BTreeIndex()
+{
+	mapping = NULL;
+	mappingLength = 0;
+	layout();
+}
+
+/**
+ * Copy constructor.
+ * 
+ * The copy constructor copies the items of the source index and lays out
+ * its own nodes, because the alignment of the node array depends on where
+ * it was allocated.  A copy of a mapped index is not mapped.
+ * 
+ * @pre an index does not exist.
+ * @post an index holding the source's items exists.
+ * 
+ * @param BTreeIndex source.
+ * 
+ */
+template< typename DataType >
+BTreeIndex< DataType >::BTreeIndex( const BTreeIndex<DataType>& source )
+{
+	mapping = NULL;
+	mappingLength = 0;
+	items.assign( source.itemData, source.itemData + source.itemCount );
+	layout();
+}
+
+/**
+ * Overloaded assignment operator.
+ * 
+ * The assignment operator copies the items of the source index and lays
+ * out the nodes again.
+ * 
+ * @pre The index exists.
+ * @post The index holds the source's items.
+ * 
+ * @param BTreeIndex source
+ * @return *this
+ * 
+ */
+template< typename DataType >
+BTreeIndex< DataType >& BTreeIndex< DataType >::operator=( const BTreeIndex<DataType>& source )
+{
+	if( this != &source )
+	{
+		vector<DataType> copied( source.itemData, source.itemData + source.itemCount );
+		
+		unmap();
+		items.swap( copied );
+		layout();
+	}
+	
+	return *this;
+}
+
+/**
+ * Destructor.
+ * 
+ * The destructor unmaps the index file if one is open.
+ * 
+ */
+template< typename DataType >
+BTreeIndex< DataType >::~BTreeIndex()
+{
+	unmap();
+}
+
+/**
+ * Build.
+ * 
+ * This function replaces the contents of the index with the items in a
+ * range, which do not need to be sorted.
+ * 
+ * @pre none
+ * @post The index holds one item for every key in the range.
+ * 
+ * @param InputIterator first.
+ * @param InputIterator last.
+ * 
+ * @note ALGORITHM: The items are copied and stable sorted by key, so that
+ * items with the same key stay in range order and the last of them can be
+ * kept.  The nodes are then laid out over the sorted items.
+ * 
+ */
+template< typename DataType >
+template< typename InputIterator >
+void BTreeIndex< DataType >::build( InputIterator first, InputIterator last )
+{
+	vector<DataType> sorted( first, last );
+	
+	stable_sort( sorted.begin(), sorted.end(), keyLess );
+	unmap();
+	items.clear();
+	
+	for( unsigned int i = 0; i < sorted.size(); i++ )
+	{
+		if( !items.empty() && items.back().getKey() == sorted[ i ].getKey() )
+		{
+			items.back() = sorted[ i ];
+		}
+		else
+		{
+			items.push_back( sorted[ i ] );
+		}
+	}
+	
+	layout();
+}
+
+/**
+ * Retrieve.
+ * 
+ * This function searches the index for a key and copies out its item.
+ * 
+ * @pre none
+ * @post If the key is found then its item is returned by reference.
+ * 
+ * @param int searchKey.
+ * @param DataType searchDataItem passed by reference.
+ * 
+ * @return Returns a bool regarding if data item was found or not.
+ * 
+ */
+template< typename DataType >
+bool BTreeIndex< DataType >::retrieve( int searchKey, DataType& searchDataItem ) const
+{
+	const DataType* found = find( searchKey );
+	
+	if( found == NULL )
+	{
+		return false;
+	}
+	
+	searchDataItem = *found;
+	return true;
+}
+
+/**
+ * Find.
+ * 
+ * This function searches the index for a key.
+ * 
+ * @pre none
+ * @post none
+ * 
+ * @param int searchKey.
+ * 
+ * @return A pointer to the item with the key, or NULL if there is none.
+ * The pointer is good until the index is built, cleared or assigned.
+ * 
+ * @note ALGORITHM: Every internal node holds, for each child after its
+ * first, the smallest key under that child.  The number of those keys
+ * that are less than or equal to searchKey is the child to descend to,
+ * and a node's children are consecutive nodes of the next level starting
+ * at node * ( NODE_KEYS + 1 ).  Separators of children that do not exist
+ * are INT_MAX, so the child is clamped for a search key of INT_MAX.  At
+ * the leaf level the number of keys less than searchKey is its position
+ * in the sorted items.
+ * 
+ */
+template< typename DataType >
+const DataType* BTreeIndex< DataType >::find( int searchKey ) const
+{
+	int leafLevel = levelCount.size() - 1;
+	int node = 0;
+	
+	for( int level = 0; level < leafLevel; level++ )
+	{
+		node = node * ( NODE_KEYS + 1 ) + countLessOrEqual( nodeKeys( level, node ), searchKey );
+		
+		if( node >= levelCount[ level + 1 ] )
+		{
+			node = levelCount[ level + 1 ] - 1;
+		}
+	}
+	
+	unsigned int position = node * NODE_KEYS + countLess( nodeKeys( leafLevel, node ), searchKey );
+	
+	if( position < unsigned( itemCount ) && itemData[ position ].getKey() == searchKey )
+	{
+		return &itemData[ position ];
+	}
+	
+	return NULL;
+}
+
+/**
+ * Write Keys.
+ * 
+ * This function writes the keys out in ascending order.
+ * 
+ */
+template< typename DataType >
+void BTreeIndex< DataType >::writeKeys() const
+{
+	for( int i = 0; i < itemCount; i++ )
+	{
+		cout << itemData[ i ].getKey() << " ";
+	}
+	
+	cout << endl;
+}
+
+/**
+ * Clear.
+ * 
+ * This function empties the index.
+ * 
+ * @post The index is empty.
+ * 
+ */
+template< typename DataType >
+void BTreeIndex< DataType >::clear()
+{
+	unmap();
+	items.clear();
+	layout();
+}
+
+/**
+ * Write.
+ * 
+ * This function writes the nodes and items of the index to a file that
+ * open can map.
+ * 
+ * @pre DataType is trivially copyable.
+ * @post The file holds the index.
+ * 
+ * @param const char* fileName.
+ * 
+ * @return bool false if the file could not be written.
+ * 
+ */
+template< typename DataType >
+bool BTreeIndex< DataType >::write( const char* fileName ) const
+{
+	static_assert( is_trivially_copyable<DataType>::value,
+	               "BTreeIndex files need a trivially copyable DataType" );
+	
+	FileHeader header;
+	ofstream file( fileName, ios::binary | ios::trunc );
+	
+	memset( &header, 0, sizeof( header ) );
+	memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+	header.itemBytes = sizeof( DataType );
+	header.itemCount = itemCount;
+	header.nodeCount = nodeCount();
+	
+	file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+	file.write( reinterpret_cast<const char*>( nodes ), size_t( header.nodeCount ) * NODE_KEYS * sizeof( int ) );
+	file.write( reinterpret_cast<const char*>( itemData ), size_t( itemCount ) * sizeof( DataType ) );
+	
+	return file.good();
+}
+
+/**
+ * Open.
+ * 
+ * This function maps an index file read-only and checks that its header
+ * matches its size and DataType.  The index then searches the file where
+ * it lies until it is built, cleared or assigned.
+ * 
+ * @pre DataType is trivially copyable.
+ * @post If the file is a valid index file then the index holds its items,
+ * otherwise the index is unchanged.
+ * 
+ * @param const char* fileName.
+ * 
+ * @return bool false if the file could not be mapped or is not valid.
+ * 
+ * @note ALGORITHM: The node counts of the levels depend only on the number
+ * of items, so they are worked out again rather than stored.  The mapping
+ * starts on a page boundary and the header is 64 bytes, so every node is
+ * still on a cache line boundary.
+ * 
+ */
+template< typename DataType >
+bool BTreeIndex< DataType >::open( const char* fileName )
+{
+	static_assert( is_trivially_copyable<DataType>::value,
+	               "BTreeIndex files need a trivially copyable DataType" );
+	
+	struct stat status;
+	int fd = ::open( fileName, O_RDONLY );
+	
+	if( fd < 0 )
+	{
+		return false;
+	}
+	
+	if( fstat( fd, &status ) != 0 || size_t( status.st_size ) < sizeof( FileHeader ) )
+	{
+		::close( fd );
+		return false;
+	}
+	
+	size_t newLength = status.st_size;
+	void* newMapping = mmap( NULL, newLength, PROT_READ, MAP_SHARED, fd, 0 );
+	
+	::close( fd );
+	
+	if( newMapping == MAP_FAILED )
+	{
+		return false;
+	}
+	
+	const FileHeader* header = static_cast<const FileHeader*>( newMapping );
+	vector<int> oldStart, oldCount;
+	
+	oldStart.swap( levelStart );
+	oldCount.swap( levelCount );
+	sizeLevels( header->itemCount );
+	
+	uint64_t nodeBytes = uint64_t( header->nodeCount ) * NODE_KEYS * sizeof( int );
+	
+	if( memcmp( header->magic, MAGIC, sizeof( MAGIC ) ) != 0
+	    || header->itemBytes != sizeof( DataType )
+	    || header->itemCount > uint32_t( INT_MAX )
+	    || int( header->nodeCount ) != nodeCount()
+	    || sizeof( FileHeader ) + nodeBytes + uint64_t( header->itemCount ) * sizeof( DataType ) != newLength )
+	{
+		levelStart.swap( oldStart );
+		levelCount.swap( oldCount );
+		munmap( newMapping, newLength );
+		return false;
+	}
+	
+	unmap();
+	vector<DataType>().swap( items );
+	vector<int>().swap( storage );
+	
+	mapping = newMapping;
+	mappingLength = newLength;
+	nodes = reinterpret_cast<const int*>( static_cast<const char*>( mapping ) + sizeof( FileHeader ) );
+	itemData = reinterpret_cast<const DataType*>( static_cast<const char*>( mapping ) + sizeof( FileHeader ) + nodeBytes );
+	itemCount = header->itemCount;
+	
+	return true;
+}
+
+/**
+ * Empty Check.
+ * 
+ * @return Returns a bool with result of if the index holds no items.
+ * 
+ */
+template< typename DataType >
+bool BTreeIndex< DataType >::isEmpty() const
+{
+	return ( itemCount == 0 );
+}
+
+/**
+ * Get Count.
+ * 
+ * @return int count of items.
+ * 
+ */
+template< typename DataType >
+int BTreeIndex< DataType >::getCount() const
+{
+	return itemCount;
+}
+
+/**
+ * Get Height.
+ * 
+ * @return The number of node levels, which is the number of nodes a
+ * search visits.
+ * 
+ */
+template< typename DataType >
+int BTreeIndex< DataType >::getHeight() const
+{
+	return levelCount.size();
+}
+
+/**
+ * Key Less.
+ * 
+ * @return bool true if the key of a is less than the key of b.
+ * 
+ */
+template< typename DataType >
+bool BTreeIndex< DataType >::keyLess( const DataType& a, const DataType& b )
+{
+	return ( a.getKey() < b.getKey() );
+}
+
+/**
+ * Size Levels.
+ * 
+ * This function works out how many nodes each level has for a number of
+ * items, and where each level starts.
+ * 
+ * @param int count of items.
+ * 
+ * @note ALGORITHM: The leaf level has one node for every NODE_KEYS items,
+ * and at least one node.  Each level above has one node for every
+ * NODE_KEYS + 1 nodes below it, until a level has a single node.  The
+ * levels are sized bottom up and stored root first.
+ * 
+ */
+template< typename DataType >
+void BTreeIndex< DataType >::sizeLevels( int count )
+{
+	vector<int> counts( 1, ( count + NODE_KEYS - 1 ) / NODE_KEYS );
+	
+	if( counts[ 0 ] == 0 )
+	{
+		counts[ 0 ] = 1;
+	}
+	
+	while( counts.back() > 1 )
+	{
+		counts.push_back( ( counts.back() + NODE_KEYS ) / ( NODE_KEYS + 1 ) );
+	}
+	
+	levelCount.assign( counts.rbegin(), counts.rend() );
+	levelStart.assign( levelCount.size(), 0 );
+	
+	for( unsigned int level = 1; level < levelCount.size(); level++ )
+	{
+		levelStart[ level ] = levelStart[ level - 1 ] + levelCount[ level - 1 ];
+	}
+}
+
+/**
+ * Node Count.
+ * 
+ * @return The number of nodes in all levels.
+ * 
+ */
+template< typename DataType >
+int BTreeIndex< DataType >::nodeCount() const
+{
+	return levelStart.back() + levelCount.back();
+}
+
+/**
+ * Layout.
+ * 
+ * This function builds the nodes over the sorted items.
+ * 
+ * @pre items is sorted by key with no key twice, and no file is mapped.
+ * @post The nodes index the items.
+ * 
+ * @note ALGORITHM: The leaf level holds the keys of the items, NODE_KEYS to
+ * a node and padded with INT_MAX, and the levels above are sized by
+ * sizeLevels.  The smallest key under each node is carried up from the
+ * leaves, so a parent's separators are the smallest keys of its second
+ * and later children.
+ * The node array is offset so that every node starts on a 64 byte
+ * boundary and fills exactly one cache line.
+ * 
+ */
+template< typename DataType >
+void BTreeIndex< DataType >::layout()
+{
+	sizeLevels( items.size() );
+	
+	int lineInts = 64 / sizeof( int );
+	
+	storage.assign( nodeCount() * NODE_KEYS + lineInts - 1, INT_MAX );
+	
+	int keysOffset = ( ( 64 - reinterpret_cast<size_t>( storage.data() ) % 64 ) % 64 ) / sizeof( int );
+	int leafLevel = levelCount.size() - 1;
+	int* leaves = &storage[ keysOffset ] + levelStart[ leafLevel ] * NODE_KEYS;
+	vector<int> smallest( levelCount[ leafLevel ] );
+	
+	for( unsigned int i = 0; i < items.size(); i++ )
+	{
+		leaves[ i ] = items[ i ].getKey();
+	}
+	
+	for( int node = 0; node < levelCount[ leafLevel ]; node++ )
+	{
+		smallest[ node ] = leaves[ node * NODE_KEYS ];
+	}
+	
+	for( int level = leafLevel - 1; level >= 0; level-- )
+	{
+		int* keys = &storage[ keysOffset ] + levelStart[ level ] * NODE_KEYS;
+		vector<int> parentSmallest( levelCount[ level ] );
+		
+		for( int node = 0; node < levelCount[ level ]; node++ )
+		{
+			int firstChild = node * ( NODE_KEYS + 1 );
+			
+			parentSmallest[ node ] = smallest[ firstChild ];
+			
+			for( int i = 0; i < NODE_KEYS; i++ )
+			{
+				if( firstChild + i + 1 < levelCount[ level + 1 ] )
+				{
+					keys[ node * NODE_KEYS + i ] = smallest[ firstChild + i + 1 ];
+				}
+			}
+		}
+		
+		smallest.swap( parentSmallest );
+	}
+	
+	nodes = &storage[ keysOffset ];
+	itemData = items.data();
+	itemCount = items.size();
+}
+
+/**
+ * Unmap.
+ * 
+ * This function unmaps the index file, if one is open.  The items and
+ * nodes must be laid out again before the index is searched.
+ * 
+ */
+template< typename DataType >
+void BTreeIndex< DataType >::unmap()
+{
+	if( mapping != NULL )
+	{
+		munmap( mapping, mappingLength );
+	}
+	
+	mapping = NULL;
+	mappingLength = 0;
+}
+
+/**
+ * Count Less.
+ * 
+ * @param int pointer keys, the NODE_KEYS keys of a node.
+ * @param int searchKey.
+ * 
+ * @return The number of keys less than searchKey.
+ * 
+ * @note ALGORITHM: With SSE2 the node is compared four keys at a time.
+ * Each comparison sets every bit of the lanes where the key is smaller,
+ * the sign bits of the four results are gathered into one mask, and the
+ * bits of the mask are counted.  There are no branches that depend on
+ * the keys.
+ * 
+ */
+template< typename DataType >
+int BTreeIndex< DataType >::countLess( const int* keys, int searchKey )
+{
+#if defined(__SSE2__)
+	__m128i search = _mm_set1_epi32( searchKey );
+	int mask = 0;
+	
+	for( int i = 0; i < NODE_KEYS; i += 4 )
+	{
+		__m128i less = _mm_cmpgt_epi32( search, _mm_load_si128( reinterpret_cast<const __m128i*>( keys + i ) ) );
+		
+		mask |= _mm_movemask_ps( _mm_castsi128_ps( less ) ) << i;
+	}
+	
+	return __builtin_popcount( mask );
+#else
+	int count = 0;
+	
+	for( int i = 0; i < NODE_KEYS; i++ )
+	{
+		count += ( keys[ i ] < searchKey );
+	}
+	
+	return count;
+#endif
+}
+
+/**
+ * Count Less Or Equal.
+ * 
+ * @param int pointer keys, the NODE_KEYS keys of a node.
+ * @param int searchKey.
+ * 
+ * @return The number of keys less than or equal to searchKey, found as
+ * NODE_KEYS less the number of keys greater than it.
+ * 
+ */
+template< typename DataType >
+int BTreeIndex< DataType >::countLessOrEqual( const int* keys, int searchKey )
+{
+#if defined(__SSE2__)
+	__m128i search = _mm_set1_epi32( searchKey );
+	int mask = 0;
+	
+	for( int i = 0; i < NODE_KEYS; i += 4 )
+	{
+		__m128i greater = _mm_cmpgt_epi32( _mm_load_si128( reinterpret_cast<const __m128i*>( keys + i ) ), search );
+		
+		mask |= _mm_movemask_ps( _mm_castsi128_ps( greater ) ) << i;
+	}
+	
+	return NODE_KEYS - __builtin_popcount( mask );
+#else
+	int count = 0;
+	
+	for( int i = 0; i < NODE_KEYS; i++ )
+	{
+		count += ( keys[ i ] <= searchKey );
+	}
+	
+	return count;
+#endif
+}
+
+/**
+ * Node Keys.
+ * 
+ * @param int level, counting the root as level zero.
+ * @param int node within the level.
+ * 
+ * @return A pointer to the NODE_KEYS keys of the node.
+ * 
+ */
+template< typename DataType >
+const int* BTreeIndex< DataType >::nodeKeys( int level, int node ) const
+{
+	return nodes + ( levelStart[ level ] + node ) * NODE_KEYS;
+}
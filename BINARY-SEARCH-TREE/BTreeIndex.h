@@ -0,0 +1,109 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 9                                    BTreeIndex.h
+//
+//  Class declaration for a static B+-tree index over int keys, such
+//  as the account index of database.cpp
+//
+//--------------------------------------------------------------------
+
+#ifndef BTREEINDEX_H
+#define BTREEINDEX_H
+
+#include <stdexcept>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <stdint.h>
+
+using namespace std;
+
+// Read-only index built once from a set of data items whose getKey()
+// returns an int.  A BSTree lookup follows one pointer per level, and
+// every level is a cache miss; this tree has no pointers at all.  Its
+// nodes hold NODE_KEYS keys in one 64 byte cache line and are laid out
+// level by level in a single array, so a million keys take five node
+// visits and a node's children are found by arithmetic.  The keys of a
+// node are compared with the search key four at a time using SSE2.
+//
+// An index can be written to a file and opened again later.  Opening
+// maps the file read-only and searches the nodes and items where they
+// lie, so nothing is read, sorted or laid out however large it is.
+//
+// File layout, in host byte order:
+//   Header   magic, item size, item count and node count, padded to
+//            64 bytes so that the nodes stay on cache line boundaries
+//   nodes    NODE_KEYS ints per node, levels root first
+//   items    the items' bytes, sorted by key
+template < typename DataType >      // DataType : item with int getKey()
+class BTreeIndex
+{
+  public:
+
+    // Constructor
+    BTreeIndex ();                                // Empty index
+    BTreeIndex ( const BTreeIndex<DataType>& other );   // Copy constructor
+    BTreeIndex& operator= ( const BTreeIndex<DataType>& other );
+						  // Overloaded assignment operator
+    ~BTreeIndex ();                               // Destructor
+
+    // Replaces the contents of the index with the items in [first, last).
+    // Of several items with the same key, the last one is kept.
+    template < typename InputIterator >
+    void build ( InputIterator first, InputIterator last );
+
+    // Index operations
+    bool retrieve ( int searchKey, DataType& searchDataItem ) const;
+    const DataType* find ( int searchKey ) const; // NULL if not found
+    void writeKeys () const;                      // Output keys
+    void clear ();                                // Clear index
+
+    // Index file operations.  DataType must be trivially copyable.
+    bool write ( const char* fileName ) const;    // False if not written
+    bool open ( const char* fileName );           // Maps the file; false
+                                                  //   if it is not valid
+
+    // Index status operations
+    bool isEmpty () const;
+    int getCount () const;                        // Number of items
+    int getHeight () const;                       // Node levels searched
+
+    static const int NODE_KEYS = 16;              // Keys per node
+
+  private:
+
+    struct FileHeader {
+	char magic[8];
+	uint32_t itemBytes;
+	uint32_t itemCount;
+	uint32_t nodeCount;
+	char padding[44];
+    };
+
+    static const char MAGIC[8];
+
+    static bool keyLess ( const DataType& a, const DataType& b );
+    void sizeLevels ( int count );
+    int nodeCount () const;
+    void layout ();
+    void unmap ();
+    static int countLess ( const int* keys, int searchKey );
+    static int countLessOrEqual ( const int* keys, int searchKey );
+    const int* nodeKeys ( int level, int node ) const;
+
+    vector<DataType> items;         // Sorted by key, unless mapped
+    vector<int> storage;            // Node keys, with room to align them
+    vector<int> levelStart;         // First node of each level, root first
+    vector<int> levelCount;         // Nodes in each level
+    const int* nodes;               // First node key, in storage or the
+                                    //   mapping
+    const DataType* itemData;       // Items, in items or the mapping
+    int itemCount;
+    void* mapping;                  // Open index file, or NULL
+    size_t mappingLength;
+};
+
+#endif	// define BTREEINDEX_H
@@ -0,0 +1,603 @@
+/**
+ * @file ConcurrentBSTree.cpp
+ * @author Amardeep Singh
+ * @brief This program creates a binary search tree that readers search
+ * without locks, by copying the path of every update and reclaiming the
+ * replaced nodes once no reader can reach them.
+*/
+#include "ConcurrentBSTree.h"
+
+/**
+ * Node constructor.
+ * 
+ * The height of the node is worked out from its subtrees, which are
+ * complete before the node is made.
+ * 
+ * @param DataType nodeDataItem passed by reference.
+ * @param Node pointer leftPtr.
+ * @param Node pointer rightPtr.
+ * @param uint64_t bornEpoch, the epoch of the update making the node.
+ * 
+ */
+template< typename DataType, class KeyType >
+ConcurrentBSTree< DataType, KeyType >::Node::Node( const DataType& nodeDataItem, const Node* leftPtr, const Node* rightPtr, uint64_t bornEpoch )
+	: dataItem( nodeDataItem ), left( leftPtr ), right( rightPtr ),
+	  height( 1 + max( heightOf( leftPtr ), heightOf( rightPtr ) ) ), born( bornEpoch )
+{
+}
+
+/**
+ * Read guard constructor.
+ * 
+ * @post The guard holds a reader slot of the tree, stamped with the
+ * current epoch.
+ * 
+ * @param ConcurrentBSTree tree passed by reference.
+ * 
+ */
+template< typename DataType, class KeyType >
+ConcurrentBSTree< DataType, KeyType >::ReadGuard::ReadGuard( const ConcurrentBSTree& tree )
+	: slot( tree.claimSlot() )
+{
+}
+
+/**
+ * Read guard destructor.
+ * 
+ * @post The reader slot is free, and no longer holds back reclaiming.
+ * 
+ */
+template< typename DataType, class KeyType >
+ConcurrentBSTree< DataType, KeyType >::ReadGuard::~ReadGuard()
+{
+	slot.epoch.store( IDLE, memory_order_release );
+}
+
+/**
+ * Default constructor.
+ * 
+ * @pre A tree does not exist.
+ * @post An empty tree exists, and every reader slot is free.
+ * 
+ */
+template< typename DataType, class KeyType >
+ConcurrentBSTree< DataType, KeyType >::ConcurrentBSTree()
+	: root( NULL ), epoch( 0 ), count( 0 )
+{
+	for( int i = 0; i < READER_SLOTS; i++ )
+	{
+		slots[ i ].epoch.store( IDLE );
+	}
+}
+
+/**
+ * Destructor.
+ * 
+ * The destructor deletes the nodes of the newest tree and every retired
+ * node.  No other thread may be using the tree.
+ * 
+ * @pre A tree exists.
+ * @post The tree is deallocated.
+ * 
+ */
+template< typename DataType, class KeyType >
+ConcurrentBSTree< DataType, KeyType >::~ConcurrentBSTree()
+{
+	vector<const Node*> pending( 1, root.load() );
+	
+	while( !pending.empty() )
+	{
+		const Node* source = pending.back();
+		
+		pending.pop_back();
+		
+		if( source != NULL )
+		{
+			pending.push_back( source->left );
+			pending.push_back( source->right );
+			delete source;
+		}
+	}
+	
+	for( unsigned int i = 0; i < retired.size(); i++ )
+	{
+		delete retired[ i ].second;
+	}
+}
+
+/**
+ * Insert.
+ * 
+ * This function inserts a data item into a new version of the tree, or
+ * replaces the item with the same key.
+ * 
+ * @pre none
+ * @post Readers that start after the insert find the item.
+ * 
+ * @param DataType newDataItem passed by reference.
+ * 
+ * @note ALGORITHM: The path from the root to the key is recorded on the
+ * way down.  A new node for the item is then joined to copies of the
+ * path's nodes from the bottom up, rotating where the AVL heights are out
+ * of balance, and the copy of the root is published.
+ * 
+ */
+template< typename DataType, class KeyType >
+void ConcurrentBSTree< DataType, KeyType >::insert( const DataType& newDataItem )
+{
+	lock_guard<mutex> guard( writeLock );
+	vector<const Node*> path;
+	vector<bool> wentLeft;
+	const Node* current = root.load( memory_order_relaxed );
+	const Node* replacement;
+	
+	while( current != NULL && current->dataItem.getKey() != newDataItem.getKey() )
+	{
+		path.push_back( current );
+		wentLeft.push_back( newDataItem.getKey() < current->dataItem.getKey() );
+		current = wentLeft.back() ? current->left : current->right;
+	}
+	
+	if( current == NULL )
+	{
+		replacement = createNode( newDataItem, NULL, NULL );
+		count.fetch_add( 1, memory_order_relaxed );
+	}
+	else
+	{
+		replacement = createNode( newDataItem, current->left, current->right );
+		discard( current );
+	}
+	
+	publish( rebuild( path, wentLeft, replacement ) );
+}
+
+/**
+ * Remove.
+ * 
+ * This function removes the data item with a key from a new version of
+ * the tree.
+ * 
+ * @pre none
+ * @post Readers that start after the remove do not find the key.
+ * 
+ * @param KeyType deleteKey passed by reference.
+ * 
+ * @return bool false if the key was not in the tree, which is left as it
+ * was.
+ * 
+ * @note ALGORITHM: A node with less than two children is replaced by its
+ * child.  Otherwise it is replaced by its in-order successor, the
+ * leftmost node of its right subtree, and that subtree is rebuilt
+ * without the successor.  The path above is then rebuilt as for insert.
+ * 
+ */
+template< typename DataType, class KeyType >
+bool ConcurrentBSTree< DataType, KeyType >::remove( const KeyType& deleteKey )
+{
+	lock_guard<mutex> guard( writeLock );
+	vector<const Node*> path;
+	vector<bool> wentLeft;
+	const Node* current = root.load( memory_order_relaxed );
+	const Node* replacement;
+	
+	while( current != NULL && current->dataItem.getKey() != deleteKey )
+	{
+		path.push_back( current );
+		wentLeft.push_back( deleteKey < current->dataItem.getKey() );
+		current = wentLeft.back() ? current->left : current->right;
+	}
+	
+	if( current == NULL )
+	{
+		return false;
+	}
+	
+	if( current->left == NULL )
+	{
+		replacement = current->right;
+	}
+	else if( current->right == NULL )
+	{
+		replacement = current->left;
+	}
+	else
+	{
+		vector<const Node*> rightPath;
+		vector<bool> rightLeft;
+		const Node* successor = current->right;
+		
+		while( successor->left != NULL )
+		{
+			rightPath.push_back( successor );
+			rightLeft.push_back( true );
+			successor = successor->left;
+		}
+		
+		const Node* right = rebuild( rightPath, rightLeft, successor->right );
+		
+		replacement = join( successor->dataItem, current->left, right );
+		discard( successor );
+	}
+	
+	discard( current );
+	count.fetch_sub( 1, memory_order_relaxed );
+	publish( rebuild( path, wentLeft, replacement ) );
+	
+	return true;
+}
+
+/**
+ * Clear.
+ * 
+ * This function publishes an empty tree and retires every node of the
+ * old one.
+ * 
+ * @pre none
+ * @post Readers that start after the clear find an empty tree.
+ * 
+ */
+template< typename DataType, class KeyType >
+void ConcurrentBSTree< DataType, KeyType >::clear()
+{
+	lock_guard<mutex> guard( writeLock );
+	vector<const Node*> pending( 1, root.load( memory_order_relaxed ) );
+	
+	while( !pending.empty() )
+	{
+		const Node* source = pending.back();
+		
+		pending.pop_back();
+		
+		if( source != NULL )
+		{
+			pending.push_back( source->left );
+			pending.push_back( source->right );
+			discard( source );
+		}
+	}
+	
+	count.store( 0, memory_order_relaxed );
+	publish( NULL );
+}
+
+/**
+ * Retrieve.
+ * 
+ * This function searches the newest version of the tree for a key
+ * without taking any lock.
+ * 
+ * @pre none
+ * @post If the key is found then its item is returned by reference.
+ * 
+ * @param KeyType searchKey passed by reference.
+ * @param DataType searchDataItem passed by reference.
+ * 
+ * @return Returns a bool regarding if data item was found or not.
+ * 
+ * @note ALGORITHM: The child is chosen with a conditional expression,
+ * which the compiler turns into a conditional move.  The direction taken
+ * at each level is random, and an if statement here mispredicted so
+ * often that lookups took twice as long.
+ * 
+ */
+template< typename DataType, class KeyType >
+bool ConcurrentBSTree< DataType, KeyType >::retrieve( const KeyType& searchKey, DataType& searchDataItem ) const
+{
+	ReadGuard guard( *this );
+	const Node* current = root.load();
+	
+	while( current != NULL )
+	{
+		if( current->dataItem.getKey() == searchKey )
+		{
+			searchDataItem = current->dataItem;
+			return true;
+		}
+		
+		current = ( searchKey < current->dataItem.getKey() ) ? current->left : current->right;
+	}
+	
+	return false;
+}
+
+/**
+ * Write Keys.
+ * 
+ * This function writes the keys of the newest version of the tree out in
+ * ascending order.  Updates made while it runs are not shown.
+ * 
+ */
+template< typename DataType, class KeyType >
+void ConcurrentBSTree< DataType, KeyType >::writeKeys() const
+{
+	ReadGuard guard( *this );
+	vector<const Node*> pending;
+	const Node* current = root.load();
+	
+	while( current != NULL || !pending.empty() )
+	{
+		while( current != NULL )
+		{
+			pending.push_back( current );
+			current = current->left;
+		}
+		
+		current = pending.back();
+		pending.pop_back();
+		cout << current->dataItem.getKey() << " ";
+		current = current->right;
+	}
+	
+	cout << endl;
+}
+
+/**
+ * Empty Check.
+ * 
+ * @return Returns a bool with result of if the tree is empty.
+ * 
+ */
+template< typename DataType, class KeyType >
+bool ConcurrentBSTree< DataType, KeyType >::isEmpty() const
+{
+	return ( root.load( memory_order_acquire ) == NULL );
+}
+
+/**
+ * Get Count.
+ * 
+ * @return int count of items in the newest version of the tree.
+ * 
+ */
+template< typename DataType, class KeyType >
+int ConcurrentBSTree< DataType, KeyType >::getCount() const
+{
+	return count.load( memory_order_relaxed );
+}
+
+/**
+ * Height Of.
+ * 
+ * @return The height of a subtree, zero for an empty one.
+ * 
+ */
+template< typename DataType, class KeyType >
+int ConcurrentBSTree< DataType, KeyType >::heightOf( const Node* source )
+{
+	return ( source == NULL ) ? 0 : source->height;
+}
+
+/**
+ * Claim Slot.
+ * 
+ * This function finds a free reader slot and stamps it with the current
+ * epoch.
+ * 
+ * @return The claimed slot.
+ * 
+ * @note ALGORITHM: Each thread starts looking at the slot it used last,
+ * so a thread usually claims the same slot every time and the slot's
+ * cache line stays with it.  The slot is claimed before the root is
+ * loaded, and both are sequentially consistent, so an update that does
+ * not see the claim published its root before the reader loaded it, and
+ * the reader cannot reach the nodes that update retired.
+ * 
+ */
+template< typename DataType, class KeyType >
+typename ConcurrentBSTree< DataType, KeyType >::ReaderSlot& ConcurrentBSTree< DataType, KeyType >::claimSlot() const
+{
+	static thread_local unsigned int next = hash<thread::id>()( this_thread::get_id() );
+	
+	for( int tries = 1; ; tries++ )
+	{
+		ReaderSlot& slot = slots[ next % READER_SLOTS ];
+		uint64_t idle = IDLE;
+		
+		if( slot.epoch.compare_exchange_strong( idle, epoch.load() ) )
+		{
+			return slot;
+		}
+		
+		next++;
+		
+		if( tries % READER_SLOTS == 0 )
+		{
+			this_thread::yield();
+		}
+	}
+}
+
+/**
+ * Create Node.
+ * 
+ * @return A new node born in the current update.
+ * 
+ */
+template< typename DataType, class KeyType >
+const typename ConcurrentBSTree< DataType, KeyType >::Node* ConcurrentBSTree< DataType, KeyType >::createNode( const DataType& nodeDataItem, const Node* left, const Node* right )
+{
+	return new Node( nodeDataItem, left, right, epoch.load( memory_order_relaxed ) );
+}
+
+/**
+ * Join.
+ * 
+ * This function makes a node for an item with two subtrees whose heights
+ * differ by at most two, rotating so that the result is AVL balanced.
+ * 
+ * @param DataType nodeDataItem passed by reference.
+ * @param Node pointer left subtree.
+ * @param Node pointer right subtree.
+ * 
+ * @return The root of the joined subtree.
+ * 
+ * @note ALGORITHM: Nodes cannot be changed, so a rotation makes new
+ * nodes for the nodes it moves and discards the old ones.  A taller
+ * left subtree whose own left side is at least as tall gets a single
+ * right rotation; if its right side is taller it gets a double rotation.
+ * The right side is the mirror image.
+ * 
+ */
+template< typename DataType, class KeyType >
+const typename ConcurrentBSTree< DataType, KeyType >::Node* ConcurrentBSTree< DataType, KeyType >::join( const DataType& nodeDataItem, const Node* left, const Node* right )
+{
+	const Node* result;
+	
+	if( heightOf( left ) > heightOf( right ) + 1 )
+	{
+		if( heightOf( left->left ) >= heightOf( left->right ) )
+		{
+			result = createNode( left->dataItem, left->left, createNode( nodeDataItem, left->right, right ) );
+		}
+		else
+		{
+			const Node* middle = left->right;
+			
+			result = createNode( middle->dataItem, createNode( left->dataItem, left->left, middle->left ),
+			                     createNode( nodeDataItem, middle->right, right ) );
+			discard( middle );
+		}
+		
+		discard( left );
+	}
+	else if( heightOf( right ) > heightOf( left ) + 1 )
+	{
+		if( heightOf( right->right ) >= heightOf( right->left ) )
+		{
+			result = createNode( right->dataItem, createNode( nodeDataItem, left, right->left ), right->right );
+		}
+		else
+		{
+			const Node* middle = right->left;
+			
+			result = createNode( middle->dataItem, createNode( nodeDataItem, left, middle->left ),
+			                     createNode( right->dataItem, middle->right, right->right ) );
+			discard( middle );
+		}
+		
+		discard( right );
+	}
+	else
+	{
+		result = createNode( nodeDataItem, left, right );
+	}
+	
+	return result;
+}
+
+/**
+ * Rebuild.
+ * 
+ * This function copies a path of nodes from the bottom up onto a new
+ * subtree that takes the place of the path's last step.
+ * 
+ * @param vector path, the nodes from the top of the path down.
+ * @param vector wentLeft, true where the path went to the left child.
+ * @param Node pointer source, the new subtree at the bottom of the path.
+ * 
+ * @return The copy of the top of the path, or source if the path is
+ * empty.
+ * 
+ */
+template< typename DataType, class KeyType >
+const typename ConcurrentBSTree< DataType, KeyType >::Node* ConcurrentBSTree< DataType, KeyType >::rebuild( const vector<const Node*>& path, const vector<bool>& wentLeft, const Node* source )
+{
+	for( int i = int( path.size() ) - 1; i >= 0; i-- )
+	{
+		const Node* parent = path[ i ];
+		
+		if( wentLeft[ i ] )
+		{
+			source = join( parent->dataItem, source, parent->right );
+		}
+		else
+		{
+			source = join( parent->dataItem, parent->left, source );
+		}
+		
+		discard( parent );
+	}
+	
+	return source;
+}
+
+/**
+ * Discard.
+ * 
+ * This function gets rid of a node that the new version of the tree no
+ * longer uses.
+ * 
+ * @post A node made by the current update, which no reader can have
+ * seen, is deleted.  Any other node is retired at the current epoch.
+ * 
+ * @param Node pointer source.
+ * 
+ */
+template< typename DataType, class KeyType >
+void ConcurrentBSTree< DataType, KeyType >::discard( const Node* source )
+{
+	uint64_t current = epoch.load( memory_order_relaxed );
+	
+	if( source->born == current )
+	{
+		delete source;
+	}
+	else
+	{
+		retired.push_back( make_pair( current, source ) );
+	}
+}
+
+/**
+ * Publish.
+ * 
+ * This function makes a new version of the tree visible to readers and
+ * ends the current update.
+ * 
+ * @pre The writeLock is held.
+ * @post Readers that start now search newRoot, the epoch has moved on,
+ * and retired nodes that no reader can reach are deleted.
+ * 
+ * @param Node pointer newRoot.
+ * 
+ */
+template< typename DataType, class KeyType >
+void ConcurrentBSTree< DataType, KeyType >::publish( const Node* newRoot )
+{
+	root.store( newRoot );
+	epoch.store( epoch.load( memory_order_relaxed ) + 1 );
+	reclaim();
+}
+
+/**
+ * Reclaim.
+ * 
+ * This function deletes the retired nodes that no reader can reach.
+ * 
+ * @note ALGORITHM: A node retired at epoch e was replaced before the
+ * epoch moved past e, so a reader whose slot holds a later epoch loaded
+ * a root that does not reach it.  The oldest epoch in any claimed slot
+ * bounds what can be deleted, and as retired is in epoch order the nodes
+ * to delete are at its front.
+ * 
+ */
+template< typename DataType, class KeyType >
+void ConcurrentBSTree< DataType, KeyType >::reclaim()
+{
+	uint64_t oldest = IDLE;
+	unsigned int freed = 0;
+	
+	for( int i = 0; i < READER_SLOTS; i++ )
+	{
+		oldest = min( oldest, slots[ i ].epoch.load() );
+	}
+	
+	while( freed < retired.size() && retired[ freed ].first < oldest )
+	{
+		delete retired[ freed ].second;
+		freed++;
+	}
+	
+	retired.erase( retired.begin(), retired.begin() + freed );
+}
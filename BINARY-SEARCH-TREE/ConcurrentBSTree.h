@@ -0,0 +1,128 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 9                                    ConcurrentBSTree.h
+//
+//  Class declaration for a binary search tree that many threads can
+//  search without locks while updates are applied
+//
+//--------------------------------------------------------------------
+
+#ifndef CONCURRENTBSTREE_H
+#define CONCURRENTBSTREE_H
+
+#include <stdexcept>
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <cstdint>
+
+using namespace std;
+
+// Read-mostly search tree.  Nodes are never changed once other threads
+// can reach them: an update copies the nodes on the path from the root
+// to the change, shares every other node with the old tree, and then
+// publishes the new root with a single atomic store.  A reader loads
+// the root once and searches that version of the tree without locks,
+// however many updates happen meanwhile.  Updates take a mutex, so one
+// thread at a time applies them.
+//
+// Replaced nodes cannot be deleted while a reader might still be in the
+// old tree, so they are reclaimed by epoch.  A reader claims one of
+// READER_SLOTS slots holding the epoch at which it started, and every
+// update retires the nodes it replaced at the current epoch and moves
+// the epoch on.  Retired nodes are deleted once every claimed slot holds
+// a later epoch.  The tree is kept AVL balanced, so an update copies at
+// most about 1.44 log2(n) nodes.
+template < typename DataType, class KeyType >    // DataType : tree data item
+class ConcurrentBSTree                           // KeyType : key field
+{
+  public:
+
+    static const int READER_SLOTS = 64;         // Readers at one time
+
+    // Constructor
+    ConcurrentBSTree ();                         // Default constructor
+    ~ConcurrentBSTree ();                        // No thread may be using
+                                                 //   the tree
+
+    // Update operations, one thread at a time
+    void insert ( const DataType& newDataItem );  // Insert data item
+    bool remove ( const KeyType& deleteKey );     // Remove data item
+    void clear ();                                // Clear tree
+
+    // Read operations, lock free
+    bool retrieve ( const KeyType& searchKey, DataType& searchDataItem ) const;
+                                                  // Retrieve data item
+    void writeKeys () const;                      // Output keys of one
+                                                  //   version of the tree
+
+    // Binary search tree status operations
+    bool isEmpty () const;                        // Tree is empty
+    int getCount () const;                        // Number of items
+
+  private:
+
+    // Not copyable: a copy could not share the readers' epochs.
+    ConcurrentBSTree ( const ConcurrentBSTree& other );
+    ConcurrentBSTree& operator= ( const ConcurrentBSTree& other );
+
+    class Node
+    {
+      public:
+        Node ( const DataType& nodeDataItem, const Node* leftPtr,
+               const Node* rightPtr, uint64_t bornEpoch );
+
+        const DataType dataItem;
+        const Node* const left;
+        const Node* const right;
+        const int height;               // Height of the subtree at this node
+        const uint64_t born;            // Epoch of the update that made it
+    };
+
+    class alignas(64) ReaderSlot
+    {
+      public:
+        atomic<uint64_t> epoch;         // Epoch the reader started at, or
+                                        //   IDLE
+    };
+
+    // Claims a reader slot for as long as the guard lives.
+    class ReadGuard
+    {
+      public:
+        ReadGuard ( const ConcurrentBSTree& tree );
+        ~ReadGuard ();
+
+      private:
+        ReaderSlot& slot;
+    };
+
+    static const uint64_t IDLE = UINT64_MAX;
+
+    static int heightOf ( const Node* source );
+    ReaderSlot& claimSlot () const;
+    const Node* createNode ( const DataType& nodeDataItem, const Node* left,
+                             const Node* right );
+    const Node* join ( const DataType& nodeDataItem, const Node* left,
+                       const Node* right );
+    const Node* rebuild ( const vector<const Node*>& path,
+                          const vector<bool>& wentLeft, const Node* source );
+    void discard ( const Node* source );
+    void publish ( const Node* newRoot );
+    void reclaim ();
+
+    atomic<const Node*> root;           // Newest version of the tree
+    atomic<uint64_t> epoch;             // Moves on after every update
+    atomic<int> count;
+    mutex writeLock;                    // Held by the updating thread
+    vector< pair<uint64_t, const Node*> > retired;
+                                        // Replaced nodes and the epoch
+                                        //   they were replaced at, oldest
+                                        //   first
+    mutable ReaderSlot slots[ READER_SLOTS ];
+};
+
+#endif	// define CONCURRENTBSTREE_H
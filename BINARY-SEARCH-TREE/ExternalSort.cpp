@@ -0,0 +1,338 @@
+/**
+ * @file ExternalSort.cpp
+ * @author Amardeep Singh
+ * @brief This program sorts data items by key in runs, spilling the runs
+ * to temporary files when there are too many items to hold in memory.
+*/
+#include "ExternalSort.h"
+
+/**
+ * Constructor.
+ * 
+ * @post The sort holds no items.
+ * 
+ * @param int runItems, the most items held in memory while adding.
+ * 
+ */
+template< typename DataType >
+ExternalSort< DataType >::ExternalSort( int runItems )
+{
+	this->runItems = ( runItems > 0 ) ? runItems : 1;
+	position = 0;
+	failed = false;
+}
+
+/**
+ * Destructor.
+ * 
+ * The destructor closes the run files, which removes them.
+ * 
+ */
+template< typename DataType >
+ExternalSort< DataType >::~ExternalSort()
+{
+	for( unsigned int i = 0; i < files.size(); i++ )
+	{
+		fclose( files[ i ] );
+	}
+}
+
+/**
+ * Add.
+ * 
+ * This function adds an item to the run being filled, and writes the run
+ * out once it is full.
+ * 
+ * @pre finish has not been called.
+ * @post The item is part of the sort.
+ * 
+ * @param DataType item passed by reference.
+ * 
+ */
+template< typename DataType >
+void ExternalSort< DataType >::add( const DataType& item )
+{
+	run.push_back( item );
+	
+	if( int( run.size() ) == runItems )
+	{
+		writeRun();
+	}
+}
+
+/**
+ * Finish.
+ * 
+ * This function ends the adding and gets the items ready to be read back
+ * in key order.
+ * 
+ * @pre finish has not been called.
+ * @post next returns the items in ascending key order.
+ * 
+ * @return The number of distinct keys, which is how many times next may
+ * be called.
+ * 
+ * @note ALGORITHM: If no run was written out, the items are sorted where
+ * they are.  Otherwise the last run is written out too, and the run files
+ * are merged once only to count the keys, then rewound for next.
+ * 
+ */
+template< typename DataType >
+int ExternalSort< DataType >::finish()
+{
+	if( files.empty() )
+	{
+		sortRun();
+		position = 0;
+		return run.size();
+	}
+	
+	if( !run.empty() )
+	{
+		writeRun();
+	}
+	
+	int count = 0;
+	
+	startMerge();
+	
+	while( mergeNext() )
+	{
+		count++;
+	}
+	
+	startMerge();
+	return count;
+}
+
+/**
+ * Next.
+ * 
+ * @pre finish has been called, and next has been called fewer times than
+ * the number of keys finish returned.
+ * 
+ * @return The item with the next larger key.
+ * 
+ */
+template< typename DataType >
+const DataType& ExternalSort< DataType >::next()
+{
+	if( files.empty() )
+	{
+		return run[ position++ ];
+	}
+	
+	mergeNext();
+	return current;
+}
+
+/**
+ * Good.
+ * 
+ * @return bool false if a run file could not be created, written or
+ * read, in which case the items read back are not to be trusted.
+ * 
+ */
+template< typename DataType >
+bool ExternalSort< DataType >::good() const
+{
+	return !failed;
+}
+
+/**
+ * Key Less.
+ * 
+ * @return bool true if the key of a is less than the key of b.
+ * 
+ */
+template< typename DataType >
+bool ExternalSort< DataType >::keyLess( const DataType& a, const DataType& b )
+{
+	return ( a.getKey() < b.getKey() );
+}
+
+/**
+ * Sort Run.
+ * 
+ * This function sorts the items of the run in memory and drops all but
+ * the last added of the items that share a key.
+ * 
+ * @note ALGORITHM: A stable sort keeps items with the same key in the
+ * order they were added, so the last of each group is the one kept.
+ * 
+ */
+template< typename DataType >
+void ExternalSort< DataType >::sortRun()
+{
+	stable_sort( run.begin(), run.end(), keyLess );
+	
+	unsigned int kept = 0;
+	
+	for( unsigned int i = 0; i < run.size(); i++ )
+	{
+		if( kept > 0 && !keyLess( run[ kept - 1 ], run[ i ] ) )
+		{
+			run[ kept - 1 ] = run[ i ];
+		}
+		else
+		{
+			run[ kept++ ] = run[ i ];
+		}
+	}
+	
+	run.resize( kept );
+}
+
+/**
+ * Write Run.
+ * 
+ * This function sorts the run and writes it to a new temporary file.
+ * 
+ * @post The run is empty.
+ * 
+ */
+template< typename DataType >
+void ExternalSort< DataType >::writeRun()
+{
+	static_assert( is_trivially_copyable<DataType>::value,
+	               "ExternalSort run files need a trivially copyable DataType" );
+	
+	sortRun();
+	
+	FILE* file = tmpfile();
+	
+	if( file == NULL )
+	{
+		failed = true;
+	}
+	else
+	{
+		setvbuf( file, NULL, _IOFBF, 1 << 16 );
+		files.push_back( file );
+		
+		if( fwrite( run.data(), sizeof( DataType ), run.size(), file ) != run.size() )
+		{
+			failed = true;
+		}
+	}
+	
+	run.clear();
+}
+
+/**
+ * Read Head.
+ * 
+ * @param int file, the index of a run file.
+ * 
+ * @return bool true if the next item of the file was read into its head,
+ * false at the end of the file.
+ * 
+ */
+template< typename DataType >
+bool ExternalSort< DataType >::readHead( int file )
+{
+	if( fread( &heads[ file ], sizeof( DataType ), 1, files[ file ] ) == 1 )
+	{
+		return true;
+	}
+	
+	if( ferror( files[ file ] ) )
+	{
+		failed = true;
+	}
+	
+	return false;
+}
+
+/**
+ * Head After.
+ * 
+ * This function orders the heap of run files.
+ * 
+ * @return bool true if the head of run file a comes out of the merge
+ * after the head of b: its key is larger, or the keys are the same and a
+ * is the older run.
+ * 
+ */
+template< typename DataType >
+bool ExternalSort< DataType >::headAfter( int a, int b ) const
+{
+	if( keyLess( heads[ b ], heads[ a ] ) )
+	{
+		return true;
+	}
+	
+	return ( !keyLess( heads[ a ], heads[ b ] ) && a < b );
+}
+
+/**
+ * Start Merge.
+ * 
+ * This function rewinds the run files and puts every one that has items
+ * on the heap.
+ * 
+ */
+template< typename DataType >
+void ExternalSort< DataType >::startMerge()
+{
+	heads.resize( files.size() );
+	heap.clear();
+	
+	for( unsigned int i = 0; i < files.size(); i++ )
+	{
+		rewind( files[ i ] );
+		
+		if( readHead( i ) )
+		{
+			heap.push_back( i );
+		}
+	}
+	
+	make_heap( heap.begin(), heap.end(), [this]( int a, int b ) { return headAfter( a, b ); } );
+}
+
+/**
+ * Merge Next.
+ * 
+ * This function takes the next key out of the merge.
+ * 
+ * @post current holds the item with the next larger key.
+ * 
+ * @return bool false if every run file is used up.
+ * 
+ * @note ALGORITHM: The run file at the top of the heap has the smallest
+ * head, and of the files whose heads have that key it is the newest, so
+ * its head is the item to keep.  Every file whose head has that key then
+ * moves on to its next item and goes back on the heap if it has one.
+ * Each run holds a key at most once, so a file's next item always has a
+ * larger key.
+ * 
+ */
+template< typename DataType >
+bool ExternalSort< DataType >::mergeNext()
+{
+	auto after = [this]( int a, int b ) { return headAfter( a, b ); };
+	
+	if( heap.empty() )
+	{
+		return false;
+	}
+	
+	current = heads[ heap.front() ];
+	
+	while( !heap.empty() && !keyLess( current, heads[ heap.front() ] ) )
+	{
+		int file = heap.front();
+		
+		pop_heap( heap.begin(), heap.end(), after );
+		heap.pop_back();
+		
+		if( readHead( file ) )
+		{
+			heap.push_back( file );
+			push_heap( heap.begin(), heap.end(), after );
+		}
+	}
+	
+	return true;
+}
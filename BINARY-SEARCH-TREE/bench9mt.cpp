@@ -0,0 +1,205 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 9                                         bench9mt.cpp
+//
+//  Read scaling benchmark for the ConcurrentBSTree.  An index of
+//  account entries is loaded, and then 1 to N reader threads (N is the
+//  number of cores) run lookups against it while one writer thread
+//  keeps updating entries.  The same run is made against a BSTree
+//  guarded by a mutex.
+//
+//  Build:  g++ -O2 -std=c++11 -pthread bench9mt.cpp -o bench9mt
+//  Usage:  bench9mt [entry count]
+//          The default is 200000 entries.
+//
+//--------------------------------------------------------------------
+
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include "BSTree.cpp"
+#include "ConcurrentBSTree.cpp"
+
+using namespace std;
+
+struct IndexEntry
+{
+    int acctID;              // (Key) Account identifier
+    long recNum;             // Record number
+
+    int getKey () const
+        { return acctID; }   // Return key field
+};
+
+const int lookupsPerThread = 2000000;
+
+// BSTree with every operation made under one mutex.
+class LockedIndex
+{
+  public:
+    void insert ( const IndexEntry& newEntry )
+        { lock_guard<mutex> guard( lock ); tree.insert( newEntry ); }
+    bool retrieve ( int searchKey, IndexEntry& entry ) const
+        { lock_guard<mutex> guard( lock ); return tree.retrieve( searchKey, entry ); }
+
+  private:
+    mutable mutex lock;
+    BSTree<IndexEntry,int,AVLBalanced> tree;
+};
+
+typedef ConcurrentBSTree<IndexEntry,int> SharedIndex;
+
+//--------------------------------------------------------------------
+
+template < typename Index >
+void reader ( const Index& index, int entryCount, unsigned int seed, int& found )
+{
+    IndexEntry entry;
+    unsigned int next = seed;
+
+    found = 0;
+
+    for ( int i = 0; i < lookupsPerThread; i++ )
+    {
+        next = next * 1103515245 + 12345;
+        if ( index.retrieve( ( next >> 8 ) % entryCount, entry ) )
+            found++;
+    }
+}
+
+template < typename Index >
+void writer ( Index& index, int entryCount, const atomic<bool>& done,
+              long& updates )
+{
+    IndexEntry entry;
+    unsigned int next = 1;
+
+    updates = 0;
+
+    while ( !done.load() )
+    {
+        next = next * 1103515245 + 12345;
+        entry.acctID = ( next >> 8 ) % entryCount;
+        entry.recNum = updates;
+        index.insert( entry );
+        updates++;
+    }
+}
+
+// Runs threads readers and one writer, and returns the reader lookups
+// per second in millions.  writeRate is set to the writer's updates per
+// second in thousands.
+template < typename Index >
+double run ( Index& index, int entryCount, unsigned int threads,
+             double& writeRate )
+{
+    vector<thread> pool;
+    vector<int> found( threads );
+    atomic<bool> done( false );
+    long updates;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    thread updater( writer<Index>, ref( index ), entryCount, cref( done ),
+                    ref( updates ) );
+    for ( unsigned int t = 0; t < threads; t++ )
+        pool.push_back( thread( reader<Index>, cref( index ), entryCount,
+                                t * 2654435761u + 1, ref( found[t] ) ) );
+    for ( unsigned int t = 0; t < threads; t++ )
+        pool[t].join();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    done.store( true );
+    updater.join();
+
+    writeRate = updates / elapsed.count() / 1e3;
+    return threads * double( lookupsPerThread ) / elapsed.count() / 1e6;
+}
+
+// Returns the first stride from 7919 up that has no factor in common
+// with entryCount, so that ( i * stride ) % entryCount for i from 0 to
+// entryCount - 1 loads every key once, in a scattered order.
+long long scatterStride ( int entryCount )
+{
+    for ( long long stride = 7919; ; stride++ )
+    {
+        long long a = stride,
+                  b = entryCount;
+
+        while ( b != 0 )
+        {
+            long long remainder = a % b;
+            a = b;
+            b = remainder;
+        }
+        if ( a == 1 )
+            return stride;
+    }
+}
+
+int main ( int argc, char **argv )
+{
+    int entryCount = ( argc > 1 ) ? atoi( argv[1] ) : 200000;
+    SharedIndex shared;
+    LockedIndex locked;
+    IndexEntry entry;
+
+    if ( entryCount <= 0 )
+    {
+        cout << "Entry count must be positive" << endl;
+        return 1;
+    }
+
+    long long stride = scatterStride( entryCount );
+
+    for ( int i = 0; i < entryCount; i++ )
+    {
+        entry.acctID = int( ( i * stride ) % entryCount );
+        entry.recNum = i;
+        shared.insert( entry );
+        locked.insert( entry );
+    }
+
+    unsigned int cores = thread::hardware_concurrency();
+    if ( cores == 0 )
+        cores = 1;
+
+    cout << entryCount << " entries, " << lookupsPerThread
+         << " lookups per reader, one writer" << endl;
+    cout << setw(8) << "readers"
+         << setw(16) << "COW Mlookups/s" << setw(10) << "speedup"
+         << setw(14) << "updates K/s"
+         << setw(18) << "mutex Mlookups/s" << setw(10) << "speedup"
+         << setw(14) << "updates K/s" << endl;
+
+    double sharedBase = 0,
+           lockedBase = 0;
+
+    for ( unsigned int threads = 1; threads <= cores;
+          threads = ( threads * 2 > cores && threads < cores ) ? cores : threads * 2 )
+    {
+        double sharedWrites, lockedWrites;
+        double sharedRate = run( shared, entryCount, threads, sharedWrites );
+        double lockedRate = run( locked, entryCount, threads, lockedWrites );
+
+        if ( threads == 1 )
+        {
+            sharedBase = sharedRate;
+            lockedBase = lockedRate;
+        }
+
+        cout << setw(8) << threads << fixed << setprecision(2)
+             << setw(16) << sharedRate << setw(9) << sharedRate / sharedBase << "x"
+             << setw(14) << sharedWrites
+             << setw(18) << lockedRate << setw(9) << lockedRate / lockedBase << "x"
+             << setw(14) << lockedWrites << endl;
+    }
+
+    return 0;
+}
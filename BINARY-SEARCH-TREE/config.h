@@ -6,5 +6,8 @@
 
 #define LAB9_TEST1	1		// Programming Exercise 2: getCount
 #define LAB9_TEST2	1		// Programming Exercise 2: getHeight
-#define LAB9_TEST3	0		// Programming Exercise 3: writeLessThan
-
+#define LAB9_TEST3	1		// Programming Exercise 3: writeLessThan
+#define LAB9_TEST4	1		// AVLBalanced tree: sorted inserts and height bound
+#define LAB9_TEST5	1		// Order statistics: select and rank
+#define LAB9_TEST6	1		// Bulk build: buildFromSorted
+#define LAB9_TEST7	1		// Instrumentation: CountingStats histograms
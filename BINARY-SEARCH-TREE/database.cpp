@@ -6,12 +6,21 @@
 //
 //--------------------------------------------------------------------
 
-// Builds a binary search tree index for the account records in the
-// text file accounts.dat.
+// Converts the account records in the text file accounts.dat to the
+// fixed-width binary file accounts.bin, builds a B+-tree index for them
+// and saves it in accounts.idx.  Later runs map the saved index and
+// read only the records asked for, until accounts.dat changes.
 
 #include <iostream>
 #include <fstream>
-#include "BSTree.cpp"
+#include <vector>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "BTreeIndex.cpp"
 
 using namespace std;
 
@@ -22,9 +31,6 @@ using namespace std;
 
 const int nameLength      = 11;   // Maximum number of characters in
                                   //   a name
-const long bytesPerRecord = 38;   // Number of bytes used to store
-                                  //   each record in the accounts
-                                  //   database file
 
 struct AccountRecord
 {
@@ -34,6 +40,11 @@ struct AccountRecord
     double balance;               // Account balance
 };
 
+const long bytesPerRecord = sizeof(AccountRecord);
+                                  // Number of bytes used to store
+                                  //   each record in the accounts
+                                  //   database file
+
 //--------------------------------------------------------------------
 //
 // Declaration specifying the database index
@@ -48,42 +59,169 @@ struct IndexEntry
         { return acctID; }   // Return key field
 };
 
+const char textFileName[]  = "accounts.dat";   // Accounts, as text
+const char acctFileName[]  = "accounts.bin";   // Accounts database
+const char indexFileName[] = "accounts.idx";   // Saved index
+
+//--------------------------------------------------------------------
+//
+// Returns true if file exists.
+//
+
+bool fileExists ( const char* file )
+{
+    struct stat status;
+
+    return ( stat(file,&status) == 0 );
+}
+
+//--------------------------------------------------------------------
+//
+// Returns true if file exists and was modified no earlier than
+// otherFile, so an index saved in file is still good for otherFile.
+//
+
+bool isUpToDate ( const char* file, const char* otherFile )
+{
+    struct stat status, otherStatus;
+
+    return ( stat(file,&status) == 0  &&
+             stat(otherFile,&otherStatus) == 0  &&
+             ( status.st_mtim.tv_sec > otherStatus.st_mtim.tv_sec  ||
+               ( status.st_mtim.tv_sec == otherStatus.st_mtim.tv_sec  &&
+                 status.st_mtim.tv_nsec >= otherStatus.st_mtim.tv_nsec ) ) );
+}
+
+//--------------------------------------------------------------------
+//
+// Copies name into a name field of an AccountRecord, cutting it short
+// at nameLength - 1 characters, and zeroes the rest of the field.
+//
+
+void setName ( char* field, const char* name )
+{
+    memset( field, 0, nameLength );
+    memcpy( field, name, min( strlen(name), size_t(nameLength - 1) ) );
+}
+
+//--------------------------------------------------------------------
+//
+// Reads the whitespace-delimited records of textFile and writes them
+// to binFile as AccountRecords, in the same order.  Names longer than
+// nameLength - 1 characters are cut short.  The records are written to
+// a temporary file that is renamed over binFile once it is complete, so
+// binFile is never left half written.  Returns false, leaving binFile
+// as it was, if textFile could not be read or binFile not written.
+//
+
+bool convertAccounts ( const char* textFile, const char* binFile )
+{
+    ifstream text ( textFile );
+    string tempFile = string( binFile ) + ".tmp";
+    AccountRecord acctRec;
+    char tempName[ 256 ];
+
+    if( !text )
+    {
+	return false;
+    }
+
+    ofstream bin ( tempFile.c_str(), ios::binary | ios::trunc );
+
+    // Zero the record once, so the padding between fields is the same
+    // in every record.
+
+    memset( &acctRec, 0, sizeof( acctRec ) );
+
+    text >> acctRec.acctID;
+
+    while( text.good() )
+    {
+	text >> tempName;
+	setName( acctRec.firstName, tempName );
+	text >> tempName;
+	setName( acctRec.lastName, tempName );
+	text >> acctRec.balance;
+	bin.write( reinterpret_cast<const char*>( &acctRec ), bytesPerRecord );
+	text >> acctRec.acctID;
+    }
+
+    bin.close();
+
+    if( text.bad() || bin.fail() || rename( tempFile.c_str(), binFile ) != 0 )
+    {
+	remove( tempFile.c_str() );
+	return false;
+    }
+
+    return true;
+}
+
 //--------------------------------------------------------------------
 
 int main ()
 {
 	cout << endl;
-    ifstream acctFile ("accounts.data");   // Accounts database file
+    int acctFile;                         // Accounts database file
     AccountRecord acctRec;                // Account record
-    BSTree<IndexEntry,int> index;         // Database index
+    vector<IndexEntry> entries;           // Entries read from the file
+    BTreeIndex<IndexEntry> index;         // Database index, built once
+                                          //   all entries are read
     IndexEntry entry;                     // Index entry
     int searchID;                         // User input account ID
     long recNum;                          // Record number
 
-    // Iterate through the database records. For each record, read the
-    // account ID and add the (account ID, record number) pair to the
-    // index.	
-    
-    double tempNumber;
-    char tempName[ 256 ];
-    
-    acctFile.clear();
-    acctFile.open( "accounts.dat" );
-    
-    recNum = acctFile.tellg();
+    // Convert accounts.dat if there is one and accounts.bin is missing
+    // or older.  Without accounts.dat, accounts.bin is used as it is.
+
+    if( fileExists( textFileName )
+        && !isUpToDate( acctFileName, textFileName )
+        && !convertAccounts( textFileName, acctFileName ) )
+    {
+	cerr << "Could not convert " << textFileName << " to "
+	     << acctFileName << endl;
+	return 1;
+    }
+
+    acctFile = open( acctFileName, O_RDONLY );
+
+    if( acctFile < 0 )
+    {
+	cerr << "Could not open " << acctFileName << endl;
+	return 1;
+    }
+
+    // Use the saved index if accounts.bin has not changed since it was
+    // written.  Otherwise iterate through the database records. For each
+    // record, add the (account ID, record number) pair to the entries,
+    // then build the index from them and save it.
     
-	acctFile >> entry.acctID;
+    if( !isUpToDate( indexFileName, acctFileName ) || !index.open( indexFileName ) )
+    {
+	vector<AccountRecord> block( 4096 );
+	ssize_t bytesRead;
 	
-	while( acctFile.good() )
+	recNum = 0;
+	
+	while( ( bytesRead = pread( acctFile, block.data(), block.size() * bytesPerRecord,
+	                            recNum * bytesPerRecord ) ) >= bytesPerRecord )
 	{
-		entry.recNum = recNum;
-		index.insert( entry );
-		acctFile >> tempName;
-		acctFile >> tempName;
-		acctFile >> tempNumber;
-		recNum = acctFile.tellg();
-		acctFile >> entry.acctID;
+		for( long i = 0; i < bytesRead / bytesPerRecord; i++ )
+		{
+			entry.acctID = block[ i ].acctID;
+			entry.recNum = recNum;
+			entries.push_back( entry );
+			recNum++;
+		}
 	}    
+	
+	index.build( entries.begin(), entries.end() );
+	
+	if( !index.write( indexFileName ) )
+	{
+		cout << "Could not save the index in " << indexFileName << endl;
+	}
+    }
 
     // Output the account IDs in ascending order.
 	
@@ -91,10 +229,6 @@ int main ()
 	index.writeKeys();
 	cout << endl;
 
-    // Clear the status flags for the database file.
-
-	acctFile.clear();    
-
     // Read an account ID from the keyboard and output the
     // corresponding record.
    
@@ -103,18 +237,10 @@ int main ()
     
     while( cin.good() )
     {
-		acctFile.clear();
-		
-		if( index.retrieve( searchID, entry ) )
+		if( index.retrieve( searchID, entry )
+		    && pread( acctFile, &acctRec, bytesPerRecord, entry.recNum * bytesPerRecord ) == bytesPerRecord )
 		{
-			acctFile.seekg( entry.recNum );
-			
-			acctFile >> acctRec.acctID;
-			acctFile >> acctRec.firstName;
-			acctFile >> acctRec.lastName;
-			acctFile >> acctRec.balance;
-			
-			cout << ( entry.recNum / 36 ) << " : ";
+			cout << entry.recNum << " : ";
 			cout << acctRec.acctID << " ";
 			cout << acctRec.firstName << " ";
 			cout << acctRec.lastName << " ";
@@ -131,6 +257,6 @@ int main ()
 		cin >> searchID;
 	}
 	
-	acctFile.close();
+	close( acctFile );
     return 0;
 }
@@ -9,8 +9,9 @@
 
 //--------------------------------------------------------------------
 
-template < typename DataType, typename KeyType >
-void BSTree<DataType,KeyType>:: showStructure () const
+template < typename DataType, typename KeyType, class Balance,
+           template < typename > class Allocator, class Instrument >
+void BSTree<DataType,KeyType,Balance,Allocator,Instrument>:: showStructure () const
 
 // Outputs the keys in a binary search tree. The tree is output
 // rotated counterclockwise 90 degrees from its conventional
@@ -30,8 +31,9 @@ void BSTree<DataType,KeyType>:: showStructure () const
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template < typename DataType, typename KeyType >
-void BSTree<DataType,KeyType>:: showHelper ( BSTreeNode *p,
+template < typename DataType, typename KeyType, class Balance,
+           template < typename > class Allocator, class Instrument >
+void BSTree<DataType,KeyType,Balance,Allocator,Instrument>:: showHelper ( BSTreeNode *p,
                                int level             ) const
 
 // Recursive helper for showStructure. 
@@ -9,6 +9,8 @@
 using namespace std;
 
 #include <iostream>
+#include <cmath>
+#include <vector>
 #include "BSTree.cpp"
 #include "config.h"
 #include "show9.cpp"
@@ -34,9 +36,18 @@ class TestData
     int keyField;                // Key for the data item
 };
 
+#if   LAB9_TEST7
+typedef CountingStats TestStats;     // Count the depth of each search
+#else
+typedef NoStats TestStats;
+#endif
+
 int main()
 {
-    BSTree<TestData,int> testTree;   // Test binary search tree
+    BSTree<TestData,int,Unbalanced,NodePool,TestStats> testTree;    // Test binary search tree
+#if   LAB9_TEST4
+    BSTree<TestData,int,AVLBalanced> balancedTree;   // Tree for the S command
+#endif
     TestData testData;               // Binary search tree data item
     int inputKey;                    // User input key
     char cmd;                        // Input command
@@ -50,7 +61,10 @@ int main()
         cout << endl << "Command: ";                  // Read command
         cin >> cmd;
         if ( cmd == '+'  ||  cmd == '?'  ||
-             cmd == '-'  ||  cmd == '<'     )
+             cmd == '-'  ||  cmd == '<'  ||
+             cmd == 'S'  ||  cmd == 's'  ||
+             cmd == '#'  ||  cmd == 'R'  ||  cmd == 'r'  ||
+             cmd == 'B'  ||  cmd == 'b'     )
            cin >> inputKey;
 
         switch ( cmd )
@@ -118,6 +132,63 @@ int main()
                break;
 #endif	// LAB9_TEST3
 
+#if   LAB9_TEST4
+          case 'S' : case 's' :                   // Balanced tree
+               cout << "Insert keys 1 to " << inputKey
+                    << " in ascending order into an empty AVL tree" << endl;
+               balancedTree.clear();
+               for ( int key = 1; key <= inputKey; key++ )
+               {
+                   testData.setKey(key);
+                   balancedTree.insert(testData);
+               }
+               cout << "AVL tree height = " << balancedTree.getHeight()
+                    << ", AVL bound 1.44 log2(n+2) = "
+                    << 1.4405 * log2( balancedTree.getCount() + 2.0 ) - 0.3277
+                    << endl;
+               if ( balancedTree.getHeight() >
+                    1.4405 * log2( balancedTree.getCount() + 2.0 ) - 0.3277 )
+                  cout << "FAILED: height is above the bound" << endl;
+               break;
+#endif	// LAB9_TEST4
+
+#if   LAB9_TEST5
+          case '#' :                              // Order statistics
+               if ( testTree.select(inputKey,testData) )
+                  cout << "Selected : position " << inputKey
+                       << " has key " << testData.getKey() << endl;
+               else
+                  cout << "No item at that position" << endl;
+               break;
+
+          case 'R' : case 'r' :                   // Order statistics
+               cout << "Rank : " << testTree.rank(inputKey)
+                    << " keys < " << inputKey << endl;
+               break;
+#endif	// LAB9_TEST5
+
+#if   LAB9_TEST6
+          case 'B' : case 'b' :                   // Bulk build
+               {
+                   vector<TestData> sorted( inputKey > 0 ? inputKey : 0 );
+                   for ( int key = 1; key <= inputKey; key++ )
+                       sorted[key-1].setKey(key);
+                   cout << "Build from keys 1 to " << inputKey << endl;
+                   testTree.buildFromSorted(sorted.begin(),sorted.end());
+                   cout << "Tree nodes count = " << testTree.getCount()
+                        << ", height = " << testTree.getHeight()
+                        << ", smallest possible = "
+                        << ceil( log2( testTree.getCount() + 1.0 ) ) << endl;
+               }
+               break;
+#endif	// LAB9_TEST6
+
+#if   LAB9_TEST7
+          case 'I' : case 'i' :                   // Instrumentation
+               testTree.getStats().showStats();
+               break;
+#endif	// LAB9_TEST7
+
           case 'Q' : case 'q' :                   // Quit test program
                break;
 
@@ -168,6 +239,46 @@ void print_help() {
          << "(Inactive : " 
 #endif
          << "In-lab Exercise 3)" << endl;
+
+    cout << "  Scnt : Insert keys 1..cnt in order " 
+#if LAB9_TEST4
+         << "(Active   : " 
+#else
+         << "(Inactive : " 
+#endif
+         << "AVLBalanced tree)" << endl;
+
+    cout << "  #pos : Select item at position     " 
+#if LAB9_TEST5
+         << "(Active   : " 
+#else
+         << "(Inactive : " 
+#endif
+         << "Order statistics)" << endl;
+
+    cout << "  Rkey : Rank, count of keys < key   " 
+#if LAB9_TEST5
+         << "(Active   : " 
+#else
+         << "(Inactive : " 
+#endif
+         << "Order statistics)" << endl;
+
+    cout << "  Bcnt : Build from keys 1..cnt      " 
+#if LAB9_TEST6
+         << "(Active   : " 
+#else
+         << "(Inactive : " 
+#endif
+         << "Bulk build)" << endl;
+
+    cout << "  I    : Search depth histograms     " 
+#if LAB9_TEST7
+         << "(Active   : " 
+#else
+         << "(Inactive : " 
+#endif
+         << "Instrumentation)" << endl;
     cout << "  Q    : Quit the test program" << endl;
     cout << endl;
 }
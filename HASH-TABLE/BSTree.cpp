@@ -5,652 +5,2062 @@
  * @date March 11th 2014
 */
 #include "BSTree.h"
+#include "ExternalSort.cpp"
+
+/**
+ * AVL Rebalance.
+ * 
+ * This function restores the AVL property at source after one of its
+ * subtrees has grown or shrunk by one level, and updates its height.
+ * 
+ * @pre Both subtrees of source are AVL trees whose heights differ by at
+ * most two.
+ * @post The subtree at source is an AVL tree holding the same keys, and
+ * source points to its (possibly new) root.
+ * 
+ * @param Node pointer source passed by reference.
+ * 
+ * @note ALGORITHM: If one subtree is two levels taller than the other, the
+ * subtree at source is rotated toward the shorter side.  When the taller
+ * subtree leans the other way (its inner child is the taller one), that
+ * child is first rotated outward, which makes the double rotation.
+ * 
+ */
+template < class Node >
+void AVLBalanced::rebalance( Node*& source )
+{
+	if( source == NULL )
+	{
+		return;
+	}
+	
+	int balance = heightOf( source->left ) - heightOf( source->right );
+	
+	if( balance > 1 )
+	{
+		if( heightOf( source->left->left ) < heightOf( source->left->right ) )
+		{
+			rotateLeft( source->left );
+		}
+		
+		rotateRight( source );
+	}
+	else if( balance < -1 )
+	{
+		if( heightOf( source->right->right ) < heightOf( source->right->left ) )
+		{
+			rotateRight( source->right );
+		}
+		
+		rotateLeft( source );
+	}
+	else
+	{
+		updateHeight( source );
+	}
+}
+
+/**
+ * AVL Height Of.
+ * 
+ * @return The height of the subtree at source, zero for an empty one.
+ * 
+ */
+template < class Node >
+int AVLBalanced::heightOf( Node* source )
+{
+	return ( source == NULL ) ? 0 : source->height;
+}
+
+/**
+ * AVL Update Height.
+ * 
+ * This function sets the height of source from the heights of its
+ * subtrees.
+ * 
+ */
+template < class Node >
+void AVLBalanced::updateHeight( Node* source )
+{
+	int leftHeight = heightOf( source->left );
+	int rightHeight = heightOf( source->right );
+	
+	source->height = ( ( leftHeight > rightHeight ) ? leftHeight : rightHeight ) + 1;
+}
+
+/**
+ * AVL Rotate Left.
+ * 
+ * This function makes the right child of source the root of the subtree.
+ * The keys stay in order because the child's left subtree, which holds
+ * the keys between the two nodes, moves over to become source's right.
+ * The child's subtree now holds every node source's did, and source's
+ * size is counted again from its new subtrees.
+ * 
+ * @pre source has a right child.
+ * @post source points to the new root of the subtree.
+ * 
+ * @param Node pointer source passed by reference.
+ * 
+ */
+template < class Node >
+void AVLBalanced::rotateLeft( Node*& source )
+{
+	Node* child = source->right;
+	
+	source->right = child->left;
+	child->left = source;
+	child->size = source->size;
+	source->size = Node::sizeOf( source->left ) + Node::sizeOf( source->right ) + 1;
+	updateHeight( source );
+	updateHeight( child );
+	source = child;
+}
+
+/**
+ * AVL Rotate Right.
+ * 
+ * This function makes the left child of source the root of the subtree.
+ * It is the mirror image of rotateLeft.
+ * 
+ * @pre source has a left child.
+ * @post source points to the new root of the subtree.
+ * 
+ * @param Node pointer source passed by reference.
+ * 
+ */
+template < class Node >
+void AVLBalanced::rotateRight( Node*& source )
+{
+	Node* child = source->left;
+	
+	source->left = child->right;
+	child->right = source;
+	child->size = source->size;
+	source->size = Node::sizeOf( source->left ) + Node::sizeOf( source->right ) + 1;
+	updateHeight( source );
+	updateHeight( child );
+	source = child;
+}
+
+/**
+ * Node Pool constructor.
+ * 
+ * @post The pool has no blocks, and its first block will hold FIRST_BLOCK
+ * nodes.
+ * 
+ */
+template < typename Node >
+NodePool< Node >::NodePool()
+{
+	unused = NULL;
+	blockEnd = NULL;
+	freeSlots = NULL;
+	nextBlock = FIRST_BLOCK;
+}
+
+/**
+ * Node Pool move constructor.
+ * 
+ * @post The pool owns the blocks of other, and other has none.
+ * 
+ * @param NodePool other passed by rvalue reference.
+ * 
+ */
+template < typename Node >
+NodePool< Node >::NodePool( NodePool&& other )
+	: blocks( std::move( other.blocks ) )
+{
+	unused = other.unused;
+	blockEnd = other.blockEnd;
+	freeSlots = other.freeSlots;
+	nextBlock = other.nextBlock;
+	other.blocks.clear();
+	other.unused = NULL;
+	other.blockEnd = NULL;
+	other.freeSlots = NULL;
+	other.nextBlock = FIRST_BLOCK;
+}
+
+/**
+ * Node Pool move assignment operator.
+ * 
+ * @pre Any nodes still in the pool need no destructor.
+ * @post The pool's own blocks are freed, and it owns the blocks of other.
+ * 
+ * @param NodePool other passed by rvalue reference.
+ * @return Dereferenced this
+ * 
+ */
+template < typename Node >
+NodePool< Node >& NodePool< Node >::operator=( NodePool&& other )
+{
+	if( this != &other )
+	{
+		release();
+		swap( blocks, other.blocks );
+		swap( unused, other.unused );
+		swap( blockEnd, other.blockEnd );
+		swap( freeSlots, other.freeSlots );
+		swap( nextBlock, other.nextBlock );
+	}
+	
+	return *this;
+}
+
+/**
+ * Node Pool destructor.
+ * 
+ * @pre Any nodes still in the pool need no destructor.
+ * @post Every block is freed.
+ * 
+ */
+template < typename Node >
+NodePool< Node >::~NodePool()
+{
+	release();
+}
+
+/**
+ * Node Pool Allocate.
+ * 
+ * @return Memory for one node, taken from the free list if a node has
+ * been removed and otherwise from the unused end of the newest block.
+ * 
+ */
+template < typename Node >
+void* NodePool< Node >::allocate()
+{
+	if( freeSlots != NULL )
+	{
+		FreeSlot* slot = freeSlots;
+		
+		freeSlots = slot->next;
+		return slot;
+	}
+	
+	if( unused == blockEnd )
+	{
+		addBlock( nextBlock );
+		
+		if( nextBlock < MAX_BLOCK )
+		{
+			nextBlock *= 2;
+		}
+	}
+	
+	void* slot = unused;
+	
+	unused += SLOT_BYTES;
+	return slot;
+}
+
+/**
+ * Node Pool Deallocate.
+ * 
+ * @pre node came from this pool and has been destroyed.
+ * @post The node's memory is on the free list.
+ * 
+ */
+template < typename Node >
+void NodePool< Node >::deallocate( Node* node )
+{
+	FreeSlot* slot = reinterpret_cast<FreeSlot*>( node );
+	
+	slot->next = freeSlots;
+	freeSlots = slot;
+}
+
+/**
+ * Node Pool Reserve.
+ * 
+ * This function makes sure the next count nodes that are not taken from
+ * the free list come from one block.
+ * 
+ * @param int count.
+ * 
+ */
+template < typename Node >
+void NodePool< Node >::reserve( int count )
+{
+	if( count > 0 && size_t( blockEnd - unused ) < count * SLOT_BYTES )
+	{
+		addBlock( count );
+	}
+}
+
+/**
+ * Node Pool Release.
+ * 
+ * This function frees every block at once.
+ * 
+ * @pre None of the nodes in the pool needs its destructor run.
+ * @post The pool is as it was when constructed.
+ * 
+ */
+template < typename Node >
+void NodePool< Node >::release()
+{
+	for( unsigned int i = 0; i < blocks.size(); i++ )
+	{
+		::operator delete( blocks[ i ] );
+	}
+	
+	blocks.clear();
+	unused = NULL;
+	blockEnd = NULL;
+	freeSlots = NULL;
+	nextBlock = FIRST_BLOCK;
+}
+
+/**
+ * Node Pool Add Block.
+ * 
+ * This function allocates a new block and hands out nodes from it from
+ * now on.  Whatever was left of the previous block is not used.
+ * 
+ * @param int count of nodes the block holds.
+ * 
+ */
+template < typename Node >
+void NodePool< Node >::addBlock( int count )
+{
+	blocks.reserve( blocks.size() + 1 );
+	unused = static_cast<char*>( ::operator new( count * SLOT_BYTES ) );
+	blockEnd = unused + count * SLOT_BYTES;
+	blocks.push_back( unused );
+}
+
+/**
+ * Histogram constructor.
+ * 
+ * @post The histogram holds no values.
+ * 
+ */
+CountingStats::Histogram::Histogram()
+{
+	for( int i = 0; i < BUCKETS; i++ )
+	{
+		counts[ i ] = 0;
+	}
+	
+	total = 0;
+	sum = 0;
+	max = 0;
+}
+
+/**
+ * Histogram Add.
+ * 
+ * @param int value, counted in bucket value, or in the last bucket if it
+ * is larger.
+ * 
+ */
+void CountingStats::Histogram::add( int value )
+{
+	counts[ ( value < BUCKETS - 1 ) ? value : BUCKETS - 1 ]++;
+	total++;
+	sum += value;
+	
+	if( value > max )
+	{
+		max = value;
+	}
+}
+
+/**
+ * Histogram Get Count.
+ * 
+ * @param int bucket, from 0 to BUCKETS - 1.
+ * 
+ * @return The number of values counted in the bucket.
+ * 
+ */
+long CountingStats::Histogram::getCount( int bucket ) const
+{
+	return counts[ bucket ];
+}
+
+/**
+ * Histogram Get Total.
+ * 
+ * @return The number of values added.
+ * 
+ */
+long CountingStats::Histogram::getTotal() const
+{
+	return total;
+}
+
+/**
+ * Histogram Get Mean.
+ * 
+ * @return The mean of the values added, or zero if there are none.
+ * 
+ */
+double CountingStats::Histogram::getMean() const
+{
+	return ( total == 0 ) ? 0.0 : double( sum ) / total;
+}
+
+/**
+ * Histogram Get Max.
+ * 
+ * @return The largest value added, or zero if there are none.
+ * 
+ */
+int CountingStats::Histogram::getMax() const
+{
+	return max;
+}
+
+/**
+ * Probe constructor.
+ * 
+ * @param CountingStats stats, which the counts go to.
+ * @param int operation, an Operation.
+ * 
+ */
+CountingStats::Probe::Probe( const CountingStats& stats, int operation )
+	: stats( stats ), operation( operation ), visited( 0 ), comparisons( 0 )
+{
+}
+
+/**
+ * Probe destructor.
+ * 
+ * @post The nodes visited and the comparisons made are added to the
+ * histograms of the operation.
+ * 
+ */
+CountingStats::Probe::~Probe()
+{
+	stats.depths[ operation ].add( visited );
+	stats.comparisons[ operation ].add( comparisons );
+}
+
+/**
+ * Get Depths.
+ * 
+ * @return The histogram of nodes visited by each operation of a kind.
+ * 
+ */
+const CountingStats::Histogram& CountingStats::getDepths( Operation operation ) const
+{
+	return depths[ operation ];
+}
+
+/**
+ * Get Comparisons.
+ * 
+ * @return The histogram of key comparisons made by each operation of a
+ * kind.
+ * 
+ */
+const CountingStats::Histogram& CountingStats::getComparisons( Operation operation ) const
+{
+	return comparisons[ operation ];
+}
+
+/**
+ * Reset Stats.
+ * 
+ * @post Every histogram is empty.
+ * 
+ */
+void CountingStats::resetStats()
+{
+	for( int i = 0; i < OPERATIONS; i++ )
+	{
+		depths[ i ] = Histogram();
+		comparisons[ i ] = Histogram();
+	}
+}
+
+/**
+ * Show Stats.
+ * 
+ * This function writes, for each kind of operation, how many there were,
+ * the mean and largest depth and comparison count, and the depth
+ * histogram as one line per depth reached.
+ * 
+ */
+void CountingStats::showStats() const
+{
+	const char* names[ OPERATIONS ] = { "retrieve", "insert", "remove" };
+	
+	for( int i = 0; i < OPERATIONS; i++ )
+	{
+		cout << names[ i ] << " : " << depths[ i ].getTotal() << " operations, depth mean "
+		     << depths[ i ].getMean() << " max " << depths[ i ].getMax()
+		     << ", comparisons mean " << comparisons[ i ].getMean()
+		     << " max " << comparisons[ i ].getMax() << endl;
+		
+		for( int bucket = 0; bucket < BUCKETS; bucket++ )
+		{
+			if( depths[ i ].getCount( bucket ) != 0 )
+			{
+				cout << "  depth " << bucket << ( bucket == BUCKETS - 1 ? "+" : "" )
+				     << " : " << depths[ i ].getCount( bucket ) << endl;
+			}
+		}
+	}
+}
 
 /**
  * Node constructor.
  * 
- * The node constructor excepts a char data and two node pointers which
- * point to the left and right nodes.  It sets them equal to dataItem,
- * left and right.
+ * The node constructor excepts a char data and two node pointers which
+ * point to the left and right nodes.  It sets them equal to dataItem,
+ * left and right.  The data item is default constructed and then
+ * assigned, so a tree of items that are only ever inserted by const
+ * reference needs nothing more of DataType than assignment.
+ * 
+ * @pre A node is uninitialized and not created.
+ * @post The created node contains the dataItem and left and right pointers
+ * to other nodes with in the list.   
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+BSTree< DataType, KeyType, Balance, Allocator, Instrument >::BSTreeNode::BSTreeNode( 
+const DataType &nodeDataItem, BSTreeNode *leftPtr, BSTreeNode *rightPtr )
+{
+	dataItem = nodeDataItem;
+	left = leftPtr;
+	right = rightPtr;
+	size = 1 + sizeOf( leftPtr ) + sizeOf( rightPtr );
+}
+
+/**
+ * Node move constructor.
+ * 
+ * This constructor is the same as the one above, except that the data
+ * item is moved into the node instead of copied.
+ * 
+ * @pre A node is uninitialized and not created.
+ * @post The created node contains the dataItem, and nodeDataItem has been
+ * moved from.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+BSTree< DataType, KeyType, Balance, Allocator, Instrument >::BSTreeNode::BSTreeNode( 
+DataType &&nodeDataItem, BSTreeNode *leftPtr, BSTreeNode *rightPtr )
+{
+	dataItem = std::move( nodeDataItem );
+	left = leftPtr;
+	right = rightPtr;
+	size = 1 + sizeOf( leftPtr ) + sizeOf( rightPtr );
+}
+
+/**
+ * Node Size Of.
+ * 
+ * @param BSTreeNode pointer source.
+ * 
+ * @return The number of nodes in the subtree at source, zero for an
+ * empty one.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+int BSTree< DataType, KeyType, Balance, Allocator, Instrument >::BSTreeNode::sizeOf( const BSTreeNode *source )
+{
+	return ( source == NULL ) ? 0 : source->size;
+}
+
+/**
+ * Default constructor.
+ * 
+ * The default constructor initializes the root to null.
+ * 
+ * @post root is equal to null.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+BSTree< DataType, KeyType, Balance, Allocator, Instrument >::BSTree()
+{
+	root = NULL;
+}
+
+/**
+ * Copy constructor.
+ * 
+ * The copy constructor accepts a tree and creates a tree.  It checks
+ * to see if the source tree is empty.  If it is empty then it sets the
+ * root equal to null otherwise it copies over the source tree 
+ * 
+ * @pre a tree does not exist.
+ * @post a tree is copied from the source tree.
+ * 
+ * @param BSTree source.
+ * 
+ * @note ALGORITHM: The pool is asked for room for every node of the
+ * source before the copy, so the copy's nodes sit together in one block.
+ * 
+ */ 
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+BSTree< DataType, KeyType, Balance, Allocator, Instrument >::BSTree( const BSTree<DataType, KeyType, Balance, Allocator, Instrument>& source )
+{
+	if( source.isEmpty() )
+	{
+		root = NULL;
+	}
+	else
+	{
+		nodes.reserve( source.getCount() );
+		copyHelper( root, source.root );
+	}
+}
+
+/**
+ * Overloaded assignment operator.
+ * 
+ * The assignment operator copies the source tree over.  It accepts a 
+ * source tree and checks to see if 'this' is equal to source.  If it is
+ * not equal to the source then it checks to see if the source tree is
+ * empty.  If it is empty then the tree is cleared and root is set equal
+ * to null.  Otherwise the contents of the source tree is copied over.
+ * 
+ * @pre The tree exists with current data.
+ * @post The tree is assigned the contents of a source tree.
+ * 
+ * @param BSTree source
+ * @return *this
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+BSTree< DataType, KeyType, Balance, Allocator, Instrument >& BSTree< DataType, KeyType, Balance, Allocator, Instrument >::operator=(
+const BSTree<DataType,KeyType,Balance,Allocator,Instrument>& source )
+{
+	if( this == &source )
+	{
+		return *this;
+	}
+	else if( source.isEmpty() )
+	{
+		clear();
+	}
+	else
+	{
+		clear();
+		nodes.reserve( source.getCount() );
+		copyHelper( root, source.root );
+	}
+	
+	return *this;
+}
+
+/**
+ * Move constructor.
+ * 
+ * The move constructor takes over the nodes of the source tree, and the
+ * allocator memory they live in, without copying anything.
+ * 
+ * @pre a tree does not exist.
+ * @post The tree holds what source held, and source is empty.
+ * 
+ * @param BSTree source passed by rvalue reference.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+BSTree< DataType, KeyType, Balance, Allocator, Instrument >::BSTree( BSTree<DataType, KeyType, Balance, Allocator, Instrument>&& source )
+	: nodes( std::move( source.nodes ) )
+{
+	root = source.root;
+	source.root = NULL;
+}
+
+/**
+ * Move assignment operator.
+ * 
+ * The move assignment operator clears the tree and then takes over the
+ * nodes of the source tree in the same way as the move constructor.
+ * 
+ * @pre The tree exists with current data.
+ * @post The tree holds what source held, and source is empty.
+ * 
+ * @param BSTree source passed by rvalue reference.
+ * @return *this
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+BSTree< DataType, KeyType, Balance, Allocator, Instrument >& BSTree< DataType, KeyType, Balance, Allocator, Instrument >::operator=( 
+BSTree<DataType,KeyType,Balance,Allocator,Instrument>&& source )
+{
+	if( this != &source )
+	{
+		clear();
+		nodes = std::move( source.nodes );
+		root = source.root;
+		source.root = NULL;
+	}
+	
+	return *this;
+}
+
+/**
+ * Destructor.
+ * 
+ * The destuctor deallocates memory if the tree is not empty.  It does this
+ * by calling the clear function.
+ * 
+ * @pre The tree has nodes or is empty.
+ * @post If the tree had nodes then they are deallocated.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+BSTree< DataType, KeyType, Balance, Allocator, Instrument >::~BSTree()
+{
+	if( !isEmpty() )
+	{
+		clear();
+	}
+}
+/**
+ * Copy Helper.
+ * 
+ * This functions helps other functions in copying the contents of a
+ * source tree to a dest tree.  It creates an exact replica of the source
+ * tree.
+ * 
+ * @pre a dest tree is created and is empty
+ * @post a dest tree contains the data of a source tree
+ * 
+ * @param BSTreeNode pointer dest pass by reference
+ * @param BSTreeNode pointer source
+ * 
+ * @note ALGORITHM: The tree is copied in pre-order.  Each source node is
+ * copied into the link that should point to it, along with its balancing
+ * information and subtree size, since the copy has the source's shape and
+ * nothing needs to move.  The function then carries on down the left side, and the
+ * right child and the link for its copy are saved on a list of pending
+ * subtrees.  When the left side runs out the most recently saved subtree
+ * is copied next.  A subtree is only saved when it exists, so a tree
+ * that leans right never saves more than one.
+ * 
+ */ 
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::copyHelper( BSTreeNode* &dest, BSTreeNode* source )
+{
+	vector<BSTreeNode**> pendingLinks;
+	vector<BSTreeNode*> pendingSources;
+	BSTreeNode** link = &dest;
+	
+	dest = NULL;
+	
+	while( true )
+	{
+		while( source != NULL )
+		{
+			*link = createNode( source->dataItem );
+			static_cast<typename Balance::NodeData&>( **link ) = *source;
+			( *link )->size = source->size;
+			
+			if( source->right != NULL )
+			{
+				pendingLinks.push_back( &( *link )->right );
+				pendingSources.push_back( source->right );
+			}
+			
+			link = &( *link )->left;
+			source = source->left;
+		}
+		
+		if( pendingSources.empty() )
+		{
+			return;
+		}
+		
+		link = pendingLinks.back();
+		source = pendingSources.back();
+		pendingLinks.pop_back();
+		pendingSources.pop_back();
+	}
+}
+
+/**
+ * Insert.
+ *
+ * This function inserts a new data item into the tree.  It does this by
+ * calling the insertHelper.
+ * 
+ * @pre A tree must exist.
+ * @post A new node will be inserted to the tree.
+ * 
+ * @param DataType newDataItem
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::insert( const DataType& newDataItem )
+{
+	insertHelper( root, newDataItem );
+}
+
+/**
+ * Move Insert.
+ * 
+ * This function inserts a new data item into the tree by moving it into
+ * its node, so none of its members are copied.
+ * 
+ * @pre A tree must exist.
+ * @post The tree holds the new item, and newDataItem has been moved from.
+ * 
+ * @param DataType newDataItem passed by rvalue reference.
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::insert( DataType&& newDataItem )
+{
+	insertHelper( root, std::move( newDataItem ) );
+}
+
+/**
+ * Emplace.
+ * 
+ * This function builds a data item from args and moves it into the tree.
+ * 
+ * @pre DataType has a constructor taking args.
+ * @post The tree holds the new item.
+ * 
+ * @param Args args passed by forwarding reference.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+template< typename... Args >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::emplace( Args&&... args )
+{
+	insert( DataType( std::forward<Args>( args )... ) );
+}
+
+/**
+ * Insert Helper.
+ * 
+ * This function helps the insert function insert a new data item into the
+ * tree.  It inserts the data item into a specific position which is dependent
+ * on the key of the data item.
+ * 
+ * @pre A tree will not have data item in it.
+ * @post The tree will contain the new data item.
+ * 
+ * @param BSTree node pointer source passed by reference.
+ * @param Item new item passed by forwarding reference, so that it is
+ * copied or moved into the tree as the caller passed it.
+ * 
+ * @note ALGORITHM: The function follows a pointer to the link being looked
+ * at, starting with source.  If the link's node has the new item's key
+ * its data item is replaced and nothing else changes.  Otherwise the link
+ * moves to the node's left pointer if the new key is less than the node's
+ * key, or to its right pointer if not.  When the link is null a new node
+ * is created there.  The size of every node passed on the way down is
+ * counted up by one, and if the key turns out to be in the tree already
+ * those sizes are put back.  If the balancing policy rebalances, every link on the
+ * way down is kept so that the policy can be given each node on the path
+ * from the bottom up, which for AVLBalanced may rotate the subtree there.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+template< typename Item >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::insertHelper( BSTreeNode* &source, Item &&newItem )
+{
+	typename Instrument::Probe probe( *this, CountingStats::INSERT );
+	vector<BSTreeNode**> path;
+	BSTreeNode** link = &source;
+	
+	while( *link != NULL )
+	{
+		probe.visit();
+		probe.compare();
+		
+		if( newItem.getKey() == ( *link )->dataItem.getKey() )
+		{
+			resizePath( source, newItem.getKey(), -1, probe );
+			( *link )->dataItem = std::forward<Item>( newItem );
+			return;
+		}
+		
+		( *link )->size++;
+		
+		if( Balance::REBALANCES )
+		{
+			path.push_back( link );
+		}
+		
+		probe.compare();
+		
+		if( newItem.getKey() < ( *link )->dataItem.getKey() )
+		{
+			link = &( *link )->left;
+		}
+		else
+		{
+			link = &( *link )->right;
+		}
+	}
+	
+	*link = createNode( std::forward<Item>( newItem ) );
+	rebalancePath( path );
+}
+
+/**
+ * Build From Sorted.
+ * 
+ * This function replaces the contents of the tree with a perfectly
+ * balanced tree of the items in a range whose keys are in ascending order.
+ * 
+ * @pre The keys of the items in [first, last) are strictly ascending.
+ * @post The tree holds the items, and its height is the smallest possible.
+ * 
+ * @param ForwardIterator first.
+ * @param ForwardIterator last.
+ * 
+ * @note ALGORITHM: The items are counted, then handed to buildHelper in
+ * order.  No keys are compared, and the whole tree takes time
+ * proportional to its size.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+template< typename ForwardIterator >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::buildFromSorted( ForwardIterator first, ForwardIterator last )
+{
+	int count = distance( first, last );
+	
+	buildHelper( [&first]() -> const DataType& { return *first++; }, count );
+}
+
+/**
+ * Build From Unsorted.
+ * 
+ * This function replaces the contents of the tree with a perfectly
+ * balanced tree of the items in a range in any order.
+ * 
+ * @pre DataType is trivially copyable, whether or not the items need
+ * more than one run.
+ * @post The tree holds one item for each key in the range, the last one
+ * with that key.  If a run file failed the tree is empty.
+ * 
+ * @param InputIterator first.
+ * @param InputIterator last.
+ * @param int runItems, the most items sorted in memory at once.
+ * 
+ * @return bool false if a run file could not be written or read.
+ * 
+ * @note ALGORITHM: The items go through an ExternalSort, which only holds
+ * runItems of them in memory while they are added, and come out of it in
+ * key order straight into buildHelper.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+template< typename InputIterator >
+bool BSTree< DataType, KeyType, Balance, Allocator, Instrument >::buildFromUnsorted( InputIterator first, InputIterator last, 
+int runItems )
+{
+	ExternalSort<DataType> sorter( runItems );
+	
+	for( ; first != last; ++first )
+	{
+		sorter.add( *first );
+	}
+	
+	int count = sorter.finish();
+	
+	if( !sorter.good() )
+	{
+		clear();
+		return false;
+	}
+	
+	buildHelper( [&sorter]() -> const DataType& { return sorter.next(); }, count );
+	
+	return sorter.good();
+}
+
+/**
+ * Build Helper.
+ * 
+ * This function helps the build functions build a perfectly balanced
+ * tree from items given in ascending key order.
+ * 
+ * @pre The calls to next return count items in ascending key order.
+ * @post The tree holds those items and nothing else.
+ * 
+ * @param Source next, called once for each item in turn.
+ * @param int count of items.
+ * 
+ * @note ALGORITHM: The root of a range of the items is its middle item,
+ * with the items before it as its left subtree and the items after it as
+ * its right subtree.  The ranges are built in order, so that each node
+ * is created from the next item.  A list of frames stands in for the
+ * recursion: a frame builds the left subtree of its range into leftRoot,
+ * then creates its node with that subtree and builds the right subtree
+ * into the node, then sets the node's size and gives it to the balancing
+ * policy, which finds nothing to move.  Only one frame per level is ever
+ * on the list and the tree is balanced, so 64 frames are plenty and the
+ * list never has to move them.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+template< typename Source >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::buildHelper( Source next, int count )
+{
+	struct Frame
+	{
+		int low, high;          // Range of items in the subtree
+		BSTreeNode** link;      // Where the subtree goes
+		BSTreeNode* leftRoot;   // Left subtree, once built
+		int stage;              // 0 left subtree, 1 node, 2 done
+	};
+	
+	vector<Frame> frames;
+	
+	clear();
+	nodes.reserve( count );
+	frames.reserve( 64 );
+	frames.push_back( Frame{ 0, count - 1, &root, NULL, 0 } );
+	
+	while( !frames.empty() )
+	{
+		Frame& frame = frames.back();
+		int middle = frame.low + ( frame.high - frame.low ) / 2;
+		
+		if( frame.low > frame.high )
+		{
+			*frame.link = NULL;
+			frames.pop_back();
+		}
+		else if( frame.stage == 0 )
+		{
+			frame.stage = 1;
+			frames.push_back( Frame{ frame.low, middle - 1, &frame.leftRoot, NULL, 0 } );
+		}
+		else if( frame.stage == 1 )
+		{
+			BSTreeNode* node = createNode( next() );
+			
+			node->left = frame.leftRoot;
+			*frame.link = node;
+			frame.stage = 2;
+			frames.push_back( Frame{ middle + 1, frame.high, &node->right, NULL, 0 } );
+		}
+		else
+		{
+			( *frame.link )->size = frame.high - frame.low + 1;
+			Balance::rebalance( *frame.link );
+			frames.pop_back();
+		}
+	}
+}
+
+/**
+ * Retrieve.
+ * 
+ * This function retrieves a copy of a data item from the tree.  It calls
+ * find in order to do this.
+ * 
+ * @pre Data item that needs to be searched for is sent to function.
+ * @post If the data item is found then it is returned by reference.
+ * 
+ * @param KeyType searchKey passed by reference.
+ * @param DataType searchDataItem passed by reference.
+ * 
+ * @return Returns a bool regarding if data item was found or not.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+bool BSTree< DataType, KeyType, Balance, Allocator, Instrument >::retrieve( 
+const KeyType& searchKey, DataType& searchDataItem ) const
+{
+	const DataType* found = find( searchKey );
+	
+	if( found == NULL )
+	{
+		return false;
+	}
+	
+	searchDataItem = *found;
+	return true;
+}
+
+/**
+ * Find.
+ * 
+ * This function searches the tree for a key without copying its item.
+ * 
+ * @pre none
+ * @post none
+ * 
+ * @param KeyType searchKey passed by reference.
+ * 
+ * @return A pointer to the item with searchKey, or NULL if there is none.
+ * The pointer is good until the item is removed or the tree is cleared.
+ * 
+ * @note ALGORITHM: Starting at the root, the function checks to see if the
+ * node's dataItem's key is equal to the search key.  If it is then the
+ * address of the node's dataItem is returned.  Otherwise it moves to the
+ * node's left child if the searchKey is less than the node's key, or to
+ * its right child if it is greater.  When there is no node left to look
+ * at the key is not in the tree.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+const DataType* BSTree< DataType, KeyType, Balance, Allocator, Instrument >::find( const KeyType& searchKey ) const
+{
+	typename Instrument::Probe probe( *this, CountingStats::RETRIEVE );
+	BSTreeNode* source = root;
+	
+	while( source != NULL )
+	{
+		probe.visit();
+		probe.compare();
+		
+		if( source->dataItem.getKey() == searchKey )
+		{
+			return &source->dataItem;
+		}
+		
+		probe.compare();
+		
+		if( searchKey < source->dataItem.getKey() )
+		{
+			source = source->left;
+		}
+		else
+		{
+			source = source->right;
+		}
+	}
+	
+	return NULL;
+}
+
+/**
+ * Remove.
+ * 
+ * This function removes a node from the tree.  It does this by using the 
+ * deleteKey to search through the tree to find the node.  It uses the
+ * removeHelper to do this.
+ * 
+ * @pre If a tree exists it will have dataItems.
+ * @post If a tree exists then if the dataItem is found it will be removed.
+ * 
+ * @param KeyType deleteKey passed by reference.
+ * 
+ * @return Returns a bool if the item was or was not removed.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+bool BSTree< DataType, KeyType, Balance, Allocator, Instrument >::remove( const KeyType& deleteKey )
+{
+	return removeHelper( root, deleteKey, NULL );
+}
+
+/**
+ * Move Remove.
+ * 
+ * This function removes a node from the tree and moves its data item out,
+ * instead of destroying it.
+ * 
+ * @pre none
+ * @post If the key was found its item is removed from the tree and moved
+ * into removedDataItem.
+ * 
+ * @param KeyType deleteKey passed by reference.
+ * @param DataType removedDataItem passed by reference.
+ * 
+ * @return Returns a bool if the item was or was not removed.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+bool BSTree< DataType, KeyType, Balance, Allocator, Instrument >::remove( const KeyType& deleteKey, DataType& removedDataItem )
+{
+	return removeHelper( root, deleteKey, &removedDataItem );
+}
+
+/**
+ * Remove Helper.
+ * 
+ * This function helps remove to remove a node from the tree.  Using the
+ * deleteKey if the item is found then it is removed from the tree.  There
+ * are three different cases that apply to a node when it is being removed.
+ * A node can have no children, one child or two children.  It accounts for
+ * all these conditions when removed the node.
  * 
- * @pre A node is uninitialized and not created.
- * @post The created node contains the dataItem and left and right pointers
- * to other nodes with in the list.   
+ * @pre A tree must exists to have a dataItem removed from it.
+ * @post If a tree exists and if the dataItem is found using the deleteKey
+ * then it is removed from the tree.
+ * 
+ * @param BSTreeNode pointer source passed by reference.
+ * @param KeyType deleteKey passed by reference.
+ * @param DataType pointer removedDataItem, where the removed item is moved
+ * to, or NULL to destroy it.
+ * 
+ * @return Returns a bool if the item was or was not removed.
+ * 
+ * @note ALGORITHM:  The function follows a pointer to the link being
+ * looked at down the tree, as insertHelper does, until the link's node has
+ * the delete key.  If the link runs out the key is not in the tree and
+ * false is returned.  A node with no children or one child is unlinked by
+ * pointing its link at the child, or at null, and is deleted.  A node with
+ * two children instead has the dataItem of the rightmost node of its left
+ * subtree moved into it, which is the next smaller key, and that node, which has no
+ * right child, is unlinked in the same way.  The size of every node passed
+ * on the way down to the node that is unlinked is counted down by one, and
+ * put back if the key is not found.  Nothing is moved until no more keys
+ * need comparing, so the removed item is moved out first.  Every node above the one that
+ * was deleted has lost a node from one of its subtrees, so when the
+ * balancing policy rebalances those nodes are given to it from the bottom
+ * up.
  * 
  */
-template< typename DataType, class KeyType >
-BSTree< DataType, KeyType >::BSTreeNode::BSTreeNode( 
-const DataType &nodeDataItem, BSTreeNode *leftPtr, BSTreeNode *rightPtr )
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+bool BSTree< DataType, KeyType, Balance, Allocator, Instrument >::removeHelper( BSTreeNode* &source, const KeyType& deleteKey, 
+DataType* removedDataItem )
 {
-	dataItem = nodeDataItem;
-	left = leftPtr;
-	right = rightPtr;
+	typename Instrument::Probe probe( *this, CountingStats::REMOVE );
+	vector<BSTreeNode**> path;
+	BSTreeNode** link = &source;
+	
+	while( *link != NULL )
+	{
+		probe.visit();
+		probe.compare();
+		
+		if( ( *link )->dataItem.getKey() == deleteKey )
+		{
+			break;
+		}
+		
+		( *link )->size--;
+		
+		if( Balance::REBALANCES )
+		{
+			path.push_back( link );
+		}
+		
+		probe.compare();
+		
+		if( deleteKey < ( *link )->dataItem.getKey() )
+		{
+			link = &( *link )->left;
+		}
+		else
+		{
+			link = &( *link )->right;
+		}
+	}
+	
+	if( *link == NULL )
+	{
+		resizePath( source, deleteKey, 1, probe );
+		return false;
+	}
+	
+	if( removedDataItem != NULL )
+	{
+		*removedDataItem = std::move( ( *link )->dataItem );
+	}
+	
+	// TWO CHILDREN
+	if( ( *link )->left != NULL && ( *link )->right != NULL )
+	{
+		BSTreeNode* target = *link;
+		
+		target->size--;
+		
+		if( Balance::REBALANCES )
+		{
+			path.push_back( link );
+		}
+		
+		link = &target->left;
+		probe.visit();
+		
+		while( ( *link )->right != NULL )
+		{
+			probe.visit();
+			( *link )->size--;
+			
+			if( Balance::REBALANCES )
+			{
+				path.push_back( link );
+			}
+			
+			link = &( *link )->right;
+		}
+		
+		target->dataItem = std::move( ( *link )->dataItem );
+	}
+	
+	// NO CHILDREN OR ONE CHILD
+	BSTreeNode* tempNode = *link;
+	
+	if( tempNode->left != NULL )
+	{
+		*link = tempNode->left;
+	}
+	else
+	{
+		*link = tempNode->right;
+	}
+	
+	destroyNode( tempNode );
+	rebalancePath( path );
+	
+	return true;
 }
 
 /**
- * Default constructor.
+ * Write Keys.
  * 
- * The default constructor initializes the root to null.
+ * This function writes the keys out in ascending order.  It calls the
+ * writeKeyHelper to do this.
  * 
- * @post root is equal to null.
+ * @pre A tree must exist.
+ * @post If a tree exists then it will write the keys out in acesnding order.
  * 
  */
-template< typename DataType, class KeyType >
-BSTree< DataType, KeyType >::BSTree()
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::writeKeys() const
 {
-	root = NULL;
+	writeKeysHelper( root );
+	cout << endl;
 }
 
 /**
- * Copy constructor.
+ * Write Key Helper.
  * 
- * The copy constructor accepts a tree and creates a tree.  It checks
- * to see if the source tree is empty.  If it is empty then it sets the
- * root equal to null otherwise it copies over the source tree 
+ * This function helps writeKey function.  It takes in a source node and
+ * write the keys in acsending order.
  * 
- * @pre a tree does not exist.
- * @post a tree is copied from the source tree.
+ * @pre A tree must exist.
+ * @post If a tree exists then it will write the keys out in acesnding order.
  * 
- * @param BSTree source.
+ * @param BSTreeNode pointer source.
  * 
- */ 
-template< typename DataType, class KeyType >
-BSTree< DataType, KeyType >::BSTree( const BSTree<DataType, KeyType>& source )
+ * @note ALGORITHM: The keys are output by inorderHelper, which visits the
+ * nodes in order without recursion.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::writeKeysHelper( BSTreeNode* source ) const
 {
-	if( source.isEmpty() )
+	inorderHelper( source, []( BSTreeNode* node, int )
 	{
-		root = NULL;
+		cout << node->dataItem.getKey() << " ";
+	} );
+}
+
+/**
+ * Clear.
+ * 
+ * This function clears the tree and gives all of its memory back.
+ * 
+ * @pre A tree must exist to get cleared.
+ * @post The tree is empty.
+ * 
+ * @note ALGORITHM: If the data items need no destructor and the allocator
+ * can release all of its nodes at once, the nodes are not visited at all;
+ * the root is set to null and the whole pool is released.  Otherwise the
+ * clearHelper destroys the nodes one by one first.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::clear()
+{
+	if( !isEmpty() && !( Allocator<BSTreeNode>::RELEASES_ALL && 
+	    is_trivially_destructible<BSTreeNode>::value ) )
+	{
+		clearHelper( root );
 	}
-	else
+	
+	root = NULL;
+	nodes.release();
+}
+
+/**
+ * Clear Helper.
+ * 
+ * This function helps the clear function in clearing the tree.
+ * 
+ * @pre A source will be passed to the function.
+ * @post The source's node will be deleted.
+ * 
+ * @param BSTreeNode pointer source passed by reference.
+ * 
+ * @note ALGORITHM: While source has a left child, the subtree is rotated
+ * right so that the left child takes source's place.  When source has no
+ * left child it is deleted and its right child takes its place.  Every
+ * rotation moves one node off the left side for good, so the tree is
+ * deleted in time proportional to its nodes and without a stack.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::clearHelper( BSTreeNode* &source )
+{
+	while( source != NULL )
 	{
-		copyHelper( root, source.root );
+		BSTreeNode* tempNode = source;
+		
+		if( tempNode->left != NULL )
+		{
+			source = tempNode->left;
+			tempNode->left = source->right;
+			source->right = tempNode;
+		}
+		else
+		{
+			source = tempNode->right;
+			destroyNode( tempNode );
+		}
 	}
 }
 
 /**
- * Overloaded assignment operator.
+ * Empty Check.
  * 
- * The assignment operator copies the source tree over.  It accepts a 
- * source tree and checks to see if 'this' is equal to source.  If it is
- * not equal to the source then it checks to see if the source tree is
- * empty.  If it is empty then the tree is cleared and root is set equal
- * to null.  Otherwise the contents of the source tree is copied over.
+ * This function checks to see if the tree is empty.
  * 
- * @pre The tree exists with current data.
- * @post The tree is assigned the contents of a source tree.
+ * @return Returns a bool with result of if root is equal to null.
  * 
- * @param BSTree source
- * @return *this
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+bool BSTree< DataType, KeyType, Balance, Allocator, Instrument >::isEmpty() const
+{
+	return ( root == NULL );
+}
+
+/**
+ * Get Count.
+ * 
+ * This function gets the number of nodes within the tree, which the root
+ * keeps as the size of its subtree.
+ * 
+ * @return int count
  * 
  */
-template< typename DataType, class KeyType >
-BSTree< DataType, KeyType>& BSTree< DataType, KeyType >::operator=(
-const BSTree<DataType,KeyType>& source )
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+int BSTree< DataType, KeyType, Balance, Allocator, Instrument >::getCount() const
 {
-	if( this == &source )
+	return BSTreeNode::sizeOf( root );
+}
+
+/**
+ * Get Height.
+ * 
+ * This function gets the height of the tree.  It does this by calling
+ * the heightHelper function.
+ * 
+ * @return The height of the tree.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+int BSTree< DataType, KeyType, Balance, Allocator, Instrument >::getHeight() const
+{	
+	return heightHelper( root );
+}
+
+/**
+ * Height Helper.
+ * 
+ * This function helps the getHeight function get the height of the tree.
+ * 
+ * @pre A tree must exist to get the height.
+ * @post The height of the tree is returned.
+ * 
+ * @param BSTreeNode pointer source
+ * 
+ * @return The hieght is returned.
+ * 
+ * @note ALGORITHM: The height is the greatest depth of any node that
+ * inorderHelper visits.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+int BSTree< DataType, KeyType, Balance, Allocator, Instrument >::heightHelper( BSTreeNode* source ) const
+{
+	int height = 0;
+	
+	inorderHelper( source, [&height]( BSTreeNode*, int depth )
 	{
-		return *this;
+		if( depth > height )
+		{
+			height = depth;
+		}
+	} );
+	
+	return height;
+}
+
+/**
+ * Select.
+ * 
+ * This function finds the data item with a given number of smaller keys
+ * in the tree, so position zero is the smallest key and getCount() - 1
+ * the largest.
+ * 
+ * @pre none
+ * @post If position is within the tree its item is returned by reference.
+ * 
+ * @param int position.
+ * @param DataType searchDataItem passed by reference.
+ * 
+ * @return Returns a bool regarding if there is an item at position.
+ * 
+ * @note ALGORITHM: The size of a node's left subtree is the number of
+ * keys below it that are smaller.  If position is less than that the item
+ * is in the left subtree, if it is equal the item is the node, and
+ * otherwise the item is in the right subtree, at position less the left
+ * subtree and the node.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+bool BSTree< DataType, KeyType, Balance, Allocator, Instrument >::select( int position, DataType& searchDataItem ) const
+{
+	BSTreeNode* source = root;
+	
+	if( position < 0 )
+	{
+		return false;
 	}
-	else if( source.isEmpty() )
+	
+	while( source != NULL )
 	{
-		clear();
+		int leftSize = BSTreeNode::sizeOf( source->left );
+		
+		if( position < leftSize )
+		{
+			source = source->left;
+		}
+		else if( position == leftSize )
+		{
+			searchDataItem = source->dataItem;
+			return true;
+		}
+		else
+		{
+			position -= leftSize + 1;
+			source = source->right;
+		}
 	}
-	else
+	
+	return false;
+}
+
+/**
+ * Rank.
+ * 
+ * This function counts the keys in the tree that are less than a search
+ * key, which need not be in the tree.  For a key in the tree it is the
+ * key's position for select.
+ * 
+ * @param KeyType searchKey passed by reference.
+ * 
+ * @return int number of keys less than searchKey.
+ * 
+ * @note ALGORITHM: The function searches for the key.  Every time it goes
+ * right, the node and its left subtree are smaller than the key and are
+ * added to the count.  When the key is found its left subtree is added.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+int BSTree< DataType, KeyType, Balance, Allocator, Instrument >::rank( const KeyType& searchKey ) const
+{
+	BSTreeNode* source = root;
+	int smaller = 0;
+	
+	while( source != NULL )
 	{
-		clear();
-		copyHelper( root, source.root );
+		if( source->dataItem.getKey() == searchKey )
+		{
+			return smaller + BSTreeNode::sizeOf( source->left );
+		}
+		
+		if( searchKey < source->dataItem.getKey() )
+		{
+			source = source->left;
+		}
+		else
+		{
+			smaller += BSTreeNode::sizeOf( source->left ) + 1;
+			source = source->right;
+		}
 	}
 	
-	return *this;
+	return smaller;
 }
 
 /**
- * Destructor.
- * 
- * The destuctor deallocates memory if the tree is not empty.  It does this
- * by calling the clear function.
+ * Get Stats.
  * 
- * @pre The tree has nodes or is empty.
- * @post If the tree had nodes then they are deallocated.
+ * @return The instrumentation policy of the tree, whose counts tell how
+ * deep the searches of retrieve, insert and remove went.
  * 
  */
-template< typename DataType, class KeyType >
-BSTree< DataType, KeyType >::~BSTree()
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+const Instrument& BSTree< DataType, KeyType, Balance, Allocator, Instrument >::getStats() const
 {
-	if( !isEmpty() )
-	{
-		clear();
-	}
+	return *this;
 }
+
 /**
- * Copy Helper.
- * 
- * This functions helps other functions in copying the contents of a
- * source tree to a dest tree.  It creates an exact replica of the source
- * tree.  This function is a recursive function and it calls itself to 
- * go through all the nodes in order to copy the tree correctly.
+ * Create Node.
  * 
- * @pre a dest tree is created and is empty
- * @post a dest tree contains the data of a source tree
- * 
- * @param BSTreeNode pointer dest pass by reference
- * @param BSTreeNode pointer source
+ * @param Item item passed by forwarding reference.
  * 
- * @note ALGORITHM: The function checks to see if the source node is 
- * empty or not.  If it is not empty then it creates a new node in the dest
- * tree with the source's data item.  The new node's left and right pointers
- * will be set equal to null.  After the new node it created the copyHelper
- * is called again with the dest node's left pointer and the source node's
- * left pointer.  The copyHelper is then called with the right pointers of
- * the source and dest nodes.  This process is recursive and helps copy
- * the tree over in pre-order.
+ * @return A new node holding a copy of item, or item moved into it, with
+ * no children, in memory from the allocator.
  * 
- */ 
-template< typename DataType, class KeyType >
-void BSTree< DataType, KeyType >::copyHelper( BSTreeNode* &dest, BSTreeNode* source )
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+template< typename Item >
+typename BSTree< DataType, KeyType, Balance, Allocator, Instrument >::BSTreeNode* BSTree< DataType, KeyType, Balance, Allocator, Instrument >::createNode( Item&& item )
 {
-	if( source != NULL )
-	{
-		dest = new BSTreeNode( source->dataItem, NULL, NULL );
-		copyHelper( dest->left, source->left );
-		copyHelper( dest->right, source->right );
-	}
-	else
-	{
-		dest = NULL;
-	}
+	return new( nodes.allocate() ) BSTreeNode( std::forward<Item>( item ), NULL, NULL );
 }
 
 /**
- * Insert.
- *
- * This function inserts a new data item into the tree.  It does this by
- * calling the insertHelper.
+ * Destroy Node.
  * 
- * @pre A tree must exist.
- * @post A new node will be inserted to the tree.
+ * This function runs a node's destructor and gives its memory back to
+ * the allocator.
+ * 
+ * @param BSTreeNode pointer node.
  * 
- * @param DataType newDataItem
  */
-template< typename DataType, class KeyType >
-void BSTree< DataType, KeyType >::insert( const DataType& newDataItem )
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::destroyNode( BSTreeNode* node )
 {
-	insertHelper( root, newDataItem );
+	node->~BSTreeNode();
+	nodes.deallocate( node );
 }
 
 /**
- * Insert Helper.
+ * Rebalance Path.
  * 
- * This function helps the insert function insert a new data item into the
- * tree.  It inserts the data item into a specific position which is dependent
- * on the key of the data item.  It does this process recursively.
+ * This function gives the balancing policy each node on a path, from the
+ * bottom up.
  * 
- * @pre A tree will not have data item in it.
- * @post The tree will contain the new data item.
+ * @pre path holds the links from the root down to the parent of a node
+ * that was inserted or removed.
+ * @post The subtree at every link on the path is rebalanced.
  * 
- * @param BSTree node pointer source passed by reference.
- * @param DataType new item passed by reference.
+ * @param vector of BSTreeNode pointer pointers path passed by reference.
  * 
- * @note ALGORITHM: This function checks to see if the source pointer 
- * is equal to null.  If it is equal to null then a new node is created and
- * the new data item is inserted to the tree.  If it is not equal to null
- * then the newItem's key is compared to source's dataItem's key to see 
- * if it is less than.  If it is less than then the insertHelper is called
- * again with the source's left node and the newItem.  Other wise the 
- * insert helper is called with the source's right and newItem because
- * it is greater than the source's key.  This process is done recursively.
+ * @note ALGORITHM: The links are pointers inside the nodes, or to root,
+ * and a rotation only changes the node a link points to, so each link is
+ * still valid after the rotations below it.
  * 
  */
-template< typename DataType, class KeyType >
-void BSTree< DataType, KeyType >::insertHelper( BSTreeNode* &source, const DataType &newItem )
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::rebalancePath( vector<BSTreeNode**>& path )
 {
-	if( source == NULL )
-	{
-		source = new BSTreeNode( newItem, NULL, NULL );
-	}
-	else if( newItem.getKey() == source->dataItem.getKey() )
-	{
-		source->dataItem = newItem;
-	}
-	else
+	for( int i = int( path.size() ) - 1; i >= 0; i-- )
 	{
-		if( newItem.getKey() < source->dataItem.getKey() )
-		{
-			insertHelper( source->left, newItem );
-		}
-		else
-		{
-			insertHelper( source->right, newItem );
-		}
+		Balance::rebalance( *path[ i ] );
 	}
 }
 
 /**
- * Retrieve.
- * 
- * This function retrieves a data item from the tree. It calls retrieve
- * helper in order to do this.
+ * Resize Path.
  * 
- * @pre Data item that needs to be searched for is sent to function.
- * @post If the data item is found then it is returned by reference.
+ * This function adds a change to the size of every node on the search
+ * path for a key, stopping above the node with the key.
  * 
- * @param KeyType searchKey passed by reference.
- * @param DataType searchDataItem passed by reference.
+ * @pre The sizes on the path were changed by a search that did not end up
+ * inserting or removing a node.
+ * @post The sizes are changed by delta.
  * 
- * @return Returns a bool regarding if data item was found or not.
+ * @param BSTreeNode pointer source, the root of the search.
+ * @param KeyType key passed by reference.
+ * @param int delta.
+ * @param Probe probe of the insert or remove, which is told of the
+ * comparisons but not the nodes, as they were visited already.
  * 
  */
-template< typename DataType, class KeyType >
-bool BSTree< DataType, KeyType >::retrieve( 
-const KeyType& searchKey, DataType& searchDataItem ) const
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::resizePath( BSTreeNode* source, const KeyType& key, int delta,
+typename Instrument::Probe& probe )
 {
-	return retrieveHelper( root, searchKey, searchDataItem );
+	while( source != NULL )
+	{
+		probe.compare();
+		
+		if( source->dataItem.getKey() == key )
+		{
+			return;
+		}
+		
+		source->size += delta;
+		probe.compare();
+		
+		if( key < source->dataItem.getKey() )
+		{
+			source = source->left;
+		}
+		else
+		{
+			source = source->right;
+		}
+	}
 }
 
 /**
- * Retrieve Helper.
+ * Inorder Helper.
  * 
- * This function helps the retrieve function search for and retrieve a
- * data item.  If the data item is found then it returns it by reference
- * and returns a bool regarding if the data item was found or not.
+ * This function visits the nodes of a subtree in ascending key order
+ * without recursion.
  * 
- * @pre A data item is not retreieved.
- * @post If a data item is found it returns by reference and returns a
- * bool if the data itemw as found or not.  It does this recursively.
+ * @pre none
+ * @post visit has been called once for every node.
  * 
  * @param BSTreeNode pointer source.
- * @param KeyType searchKey passed by reference.
- * @param DataType searchDataItem passed by reference.
+ * @param Visitor visit, called with each node and its depth, counting
+ * source as depth one.
  * 
- * @return Bool if data item was found or not.
- * @return DataType searchDataItem if item was found.
- * 
- * @note ALGORITHM: This function checks to see if the source node is 
- * empty or not.  If it is then it returns fasle.  Other wise it checks
- * to see if the source's dataItem's key is equal to the search key.
- * if it is then the source's dataItem is set equal to searchDataItem 
- * and the function returns true while searchDataItem is returned by 
- * reference.  If it is not equal to the search key then the function 
- * checks to see if the searchKey is less that the source's dataItems's
- * key.  If it is then retrieveHelper is called with the source's left
- * pointer and the searchKey and searchDataItem.  Other wise it is greater
- * and then retrieveHelper is called with source's right pointer and the
- * searchKey and searchDataItem.  This process is recursive.
+ * @note ALGORITHM: A stack holds the nodes whose left subtrees are being
+ * visited, each with its depth.  The traversal goes left from source,
+ * pushing every node it passes, then pops the top node, visits it and
+ * does the same from its right child, until the stack is empty.  The
+ * stack is never deeper than the tree, and the tree is only read, so
+ * any number of threads may traverse it at once.
  * 
  */
-template< typename DataType, class KeyType >
-bool BSTree< DataType, KeyType >::retrieveHelper( BSTreeNode* source, 
-const KeyType& searchKey, DataType& searchDataItem ) const
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+template< typename Visitor >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::inorderHelper( BSTreeNode* source, Visitor visit ) const
 {
-	if( source == NULL )
-	{
-		return false;
-	}
+	vector< pair<BSTreeNode*, int> > pending;
+	int depth = 1;
 	
-	if( source->dataItem.getKey() == searchKey )
+	while( source != NULL || !pending.empty() )
 	{
-		searchDataItem = source->dataItem;
-		return true;
-	}
-	else
-	{
-		if( searchKey < source->dataItem.getKey() )
+		while( source != NULL )
 		{
-			return retrieveHelper( source->left, searchKey, searchDataItem );
-		}
-		else
-		{
-			return retrieveHelper( source->right, searchKey, searchDataItem );
+			pending.push_back( make_pair( source, depth ) );
+			source = source->left;
+			depth++;
 		}
+		
+		source = pending.back().first;
+		depth = pending.back().second;
+		pending.pop_back();
+		
+		visit( source, depth );
+		source = source->right;
+		depth++;
 	}
 }
 
 /**
- * Remove.
- * 
- * This function removes a node from the tree.  It does this by using the 
- * deleteKey to search through the tree to find the node.  It uses the
- * removeHelper to do this.  This process is done recursively.
+ * Begin.
  * 
- * @pre If a tree exists it will have dataItems.
- * @post If a tree exists then if the dataItem is found it will be removed.
+ * @return An iterator at the item with the smallest key, or end() if the
+ * tree is empty.
  * 
- * @param KeyType deleteKey passed by reference.
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+typename BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator BSTree< DataType, KeyType, Balance, Allocator, Instrument >::begin() const
+{
+	return const_iterator( root );
+}
+
+/**
+ * End.
  * 
- * @return Returns a bool if the item was or was not removed.
+ * @return An iterator past the item with the largest key.
  * 
  */
-template< typename DataType, class KeyType >
-bool BSTree< DataType, KeyType >::remove( const KeyType& deleteKey )
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+typename BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator BSTree< DataType, KeyType, Balance, Allocator, Instrument >::end() const
 {
-	return removeHelper( root, deleteKey );
+	return const_iterator();
 }
 
 /**
- * Remove Helper.
- * 
- * This function helps remove to remove a node from the tree.  Using the
- * deleteKey if the item is found then it is removed from the tree.  There
- * are three different cases that apply to a node when it is being removed.
- * A node can have no children, one child or two children.  It accounts for
- * all these conditions when removed the node.  This process is done recursively.
+ * Lower Bound.
  * 
- * @pre A tree must exists to have a dataItem removed from it.
- * @post If a tree exists and if the dataItem is found using the deleteKey
- * then it is removed from the tree.
+ * @param KeyType searchKey passed by reference.
  * 
- * @param BSTreeNode pointer source passed by reference.
- * @param KeyType deleteKey passed by reference.
+ * @return An iterator at the smallest key that is not less than
+ * searchKey, or end() if there is none.
  * 
- * @return Returns a bool if the item was or was not removed.
+ * @note ALGORITHM: The function searches for the key.  A node whose key
+ * is not less than searchKey might be the answer, so it is pushed on the
+ * iterator's path before going left.  A node whose key is less is not,
+ * and neither is its left subtree, so the search goes right.  The last
+ * node pushed is the answer, and below it on the path are the nodes that
+ * come after it, as when an iteration has got that far from begin().
  * 
- * @note ALGORITHM:  This function checks to see if the source node is 
- * empty.  If it is empty then it returns false.  Other wise it checks to see
- * if the source's dataItem's key is equal to the delete key.  If it is 
- * equal to the key then it goes into one of three cases with the children.
- * If the source's left and right pointers are equal to null then it has
- * no children.  The source is delted, set to null and the true is returned.
- * The function then checks to see if the left or right node of the source
- * has a child.  If it does then a tempNode pointer is set equal to the
- * source. Source is moved to the appropirate left or right node and then
- * temp is deleted.  Moving source to left or right links the tree up.
- * True is returned.  If the node has two children then a tempNode is set
- * equal to the source. The tempNode is the moved to the left child once
- * and then the temp node travels down the tree to the right until it can't
- * go right any more.  This action grabs the dataItem that will replace
- * the dataItem at the source.  Once the tempNode has reached to right most
- * node it copies it's data to the source data.  The removeHelper is then
- * called with the source's left pointer and the tempNode's dataItem.
- * This allows the rightmost node to get removed from the tree while also
- * keeping the tree linked up and in order.  If the delete key is not found
- * then the removeHelper is called with the source's left if the deleteKey
- * is less than the source's dataItem's key.  Other wise removeHelper is
- * called with the source's right pointer.  This process is recursive.
- * 
- */
-template< typename DataType, class KeyType >
-bool BSTree< DataType, KeyType >::removeHelper( BSTreeNode* &source, const KeyType& deleteKey )
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+typename BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator BSTree< DataType, KeyType, Balance, Allocator, Instrument >::lowerBound( const KeyType& searchKey ) const
 {
-	if( source == NULL )
-	{
-		return false;
-	}
+	const_iterator position;
+	BSTreeNode* source = root;
 	
-	if( source->dataItem.getKey() == deleteKey )
+	while( source != NULL )
 	{
-		// NO CHILDREN
-		if( source->left == NULL && source->right == NULL )
-		{
-			delete source;
-			source = NULL;
-			return true;
-		}
-		
-		// ONE CHILD
-		else if( source->left != NULL && source->right == NULL )
-		{
-			BSTreeNode* tempNode = source;
-			source = source->left;
-			delete tempNode;
-			tempNode = NULL;
-			return true;
-		}
-		else if( source->right != NULL && source->left == NULL )
+		if( source->dataItem.getKey() < searchKey )
 		{
-			BSTreeNode* tempNode = source;
 			source = source->right;
-			delete tempNode;
-			tempNode = NULL;
-			return true;
 		}
-		
-		// TWO CHILDREN
 		else
 		{
-			BSTreeNode* tempNode = source;
-			tempNode = tempNode->left;
-			
-			while( tempNode->right != NULL )
-			{
-				tempNode = tempNode->right;
-			}
-				
-			source->dataItem = tempNode->dataItem;
-			
-			removeHelper( source->left, tempNode->dataItem.getKey() );
-				
-			return true;
+			position.path.push_back( source );
+			source = source->left;
 		}
 	}
-	else
+	
+	return position;
+}
+
+/**
+ * Upper Bound.
+ * 
+ * @param KeyType searchKey passed by reference.
+ * 
+ * @return An iterator at the smallest key that is greater than
+ * searchKey, or end() if there is none.
+ * 
+ * @note ALGORITHM: The same search as lowerBound, except that a node with
+ * searchKey itself is passed over to the right.
+ * 
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+typename BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator BSTree< DataType, KeyType, Balance, Allocator, Instrument >::upperBound( const KeyType& searchKey ) const
+{
+	const_iterator position;
+	BSTreeNode* source = root;
+	
+	while( source != NULL )
 	{
-		if( deleteKey < source->dataItem.getKey() )
+		if( searchKey < source->dataItem.getKey() )
 		{
-			return removeHelper( source->left, deleteKey );
+			position.path.push_back( source );
+			source = source->left;
 		}
 		else
 		{
-			return removeHelper( source->right, deleteKey );
+			source = source->right;
 		}
 	}
+	
+	return position;
 }
 
 /**
- * Write Keys.
+ * For Each In Range.
  * 
- * This function writes the keys out in ascending order.  It calls the
- * writeKeyHelper to do this.
+ * This function gives the items whose keys are in a range to a function,
+ * in ascending key order.
  * 
- * @pre A tree must exist.
- * @post If a tree exists then it will write the keys out in acesnding order.
+ * @pre none
+ * @post visit has been called on the items in the range, up to and
+ * including the first call that returned false.
+ * 
+ * @param KeyType lowKey passed by reference, the smallest key wanted.
+ * @param KeyType highKey passed by reference, the largest key wanted.
+ * @param Function visit, called with each item and returning a bool that
+ * is false to stop.
+ * 
+ * @return The number of items visit was called on.
+ * 
+ * @note ALGORITHM: The iteration starts at lowerBound( lowKey ), which
+ * only looks at one path down the tree, and stops at the first key above
+ * highKey.  Subtrees wholly outside the range are never entered, so a
+ * range of k items takes time proportional to the height plus k.
  * 
  */
-template< typename DataType, class KeyType >
-void BSTree< DataType, KeyType >::writeKeys() const
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+template< typename Function >
+int BSTree< DataType, KeyType, Balance, Allocator, Instrument >::forEachInRange( const KeyType& lowKey, const KeyType& highKey, 
+Function visit ) const
 {
-	writeKeysHelper( root );
-	cout << endl;
+	int visited = 0;
+	
+	for( const_iterator position = lowerBound( lowKey ); position != end(); ++position )
+	{
+		if( highKey < position->getKey() )
+		{
+			break;
+		}
+		
+		visited++;
+		
+		if( !visit( *position ) )
+		{
+			break;
+		}
+	}
+	
+	return visited;
 }
 
 /**
- * Write Key Helper.
+ * Write Less Than.
  * 
- * This function helps writeKey function.  It takes in a source node and
- * write the keys in acsending order.  The writeKeyHelper calls it self
- * recursively in order to do this.
+ * This function writes out the keys that are less than a search key, in
+ * ascending order.
  * 
- * @pre A tree must exist.
- * @post If a tree exists then it will write the keys out in acesnding order.
+ * @pre none
+ * @post The keys less than searchKey are written out.
  * 
- * @param BSTreeNode pointer source.
+ * @param KeyType searchKey passed by reference.
  * 
- * @note ALGORITHM: This function checks to see if the soure is not null.
- * If the source is not empty then it calls itself with the source's left.
- * After that it outputs the key and the calls itself with the source's right.
- * This process is a in order traversal of the list and it outputs the 
- * keys in ascending order. This is recursive function.
+ * @note ALGORITHM: The iteration starts at the smallest key and stops at
+ * lowerBound( searchKey ), the first key that is not less.
  * 
  */
-template< typename DataType, class KeyType >
-void BSTree< DataType, KeyType >::writeKeysHelper( BSTreeNode* source ) const
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::writeLessThan( const KeyType& searchKey ) const
 {
-	if( source != NULL )
+	const_iterator stop = lowerBound( searchKey );
+	
+	for( const_iterator position = begin(); position != stop; ++position )
 	{
-		writeKeysHelper( source->left );
-		cout << source->dataItem.getKey() << " ";
-		writeKeysHelper( source->right );
+		cout << position->getKey() << " ";
 	}
 }
 
 /**
- * Clear.
+ * Iterator Default Constructor.
  * 
- * This function clears a tree if it is not empty. It does this by calling
- * the clearHelper function.
- * 
- * @pre A tree must exist to get cleared.
- * @post If a tree exists then it will be cleared.
+ * This constructor creates an iterator at the end of every tree.
  * 
  */
-template< typename DataType, class KeyType >
-void BSTree< DataType, KeyType >::clear()
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::const_iterator()
 {
-	if( !isEmpty() )
-	{
-		clearHelper( root );
-	}
 }
 
 /**
- * Clear Helper.
+ * Iterator Constructor.
  * 
- * This function helps the clear function in clearing the tree.  It does
- * this recursively.
+ * This constructor starts an iteration at the smallest key of a subtree.
  * 
- * @pre A source will be passed to the function.
- * @post The source's node will be deleted.
+ * @param BSTreeNode pointer source, the root of the subtree.
  * 
- * @param BSTreeNode pointer source passed by reference.
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::const_iterator( BSTreeNode* source )
+{
+	pushLeft( source );
+}
+
+/**
+ * Iterator Dereference.
+ * 
+ * @pre The iterator is not at the end.
  * 
- * @note ALGORITHM: The function checks to see if the source's left is
- * not equal to null.  If this is true then it will call itself with 
- * source's left pointer.  It the source's right pointer is not equal to
- * null then it will call itself with source's right pointer.  After all
- * the traversal the source node is deleted and set to null.  The tree
- * is traversed in post order recursively.
+ * @return The current item.
  * 
  */
-template< typename DataType, class KeyType >
-void BSTree< DataType, KeyType >::clearHelper( BSTreeNode* &source )
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+typename BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::reference BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::operator*() const
 {
-	if( source->left != NULL )
-	{
-		clearHelper( source->left );
-	}
-	if( source->right != NULL )
-	{
-		clearHelper( source->right );
-	}
-	
-	delete source;
-	source = NULL;	
+	return path.back()->dataItem;
 }
 
 /**
- * Empty Check.
+ * Iterator Member Access.
  * 
- * This function checks to see if the tree is empty.
+ * @pre The iterator is not at the end.
  * 
- * @return Returns a bool with result of if root is equal to null.
+ * @return A pointer to the current item.
  * 
  */
-template< typename DataType, class KeyType >
-bool BSTree< DataType, KeyType >::isEmpty() const
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+typename BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::pointer BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::operator->() const
 {
-	return ( root == NULL );
+	return &path.back()->dataItem;
 }
 
 /**
- * Get Count.
+ * Iterator Pre-increment.
  * 
- * This function gets the number of nodes within the tree.  It calls 
- * countHelper to do this.  It returns the number of nodes counted.
+ * This function moves on to the item with the next larger key.
  * 
- * @return int count
+ * @pre The iterator is not at the end.
+ * @post The iterator is at the next item or at the end.
+ * 
+ * @return Dereferenced this
+ * 
+ * @note ALGORITHM: If the current node has a right subtree the next key is
+ * the leftmost node of that subtree.  Otherwise it is the nearest ancestor
+ * whose left subtree holds the current node, which is the node below it
+ * on path.
  * 
  */
-template< typename DataType, class KeyType >
-int BSTree< DataType, KeyType >::getCount() const
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+typename BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator& BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::operator++()
 {
-	int count = 0;
+	BSTreeNode* current = path.back();
 	
-	if( !isEmpty() )
-	{
-		countHelper( root, count );
-	}
+	path.pop_back();
+	pushLeft( current->right );
 	
-	return count;
+	return *this;
 }
 
 /**
- * Count Helper.
- * 
- * This function helps the getCount function count the nodes within a tree.
+ * Iterator Post-increment.
  * 
- * @pre no nodes are counted.
- * @post all the nodes are counted. 
+ * @pre The iterator is not at the end.
+ * @post The iterator is at the next item or at the end.
  * 
- * @param BSTreeNode pointer source
- * @param int count passed by referenece
+ * @return A copy of the iterator from before it moved.
  * 
- * @note ALGORITHM: This function uses a in order traversal to count all
- * the nodes within in a tree.  If the source node is not empty then it
- * calls itself with the source's left pointer and the count.  The count
- * is incremented and then countHelper is called with the source's right
- * and the count. This is done recursively.  
+ */
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+typename BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::operator++( int )
+{
+	const_iterator before = *this;
+	
+	++*this;
+	
+	return before;
+}
+
+/**
+ * Iterator Equality.
  * 
- * @return count is returned by reference.
+ * @return bool true if both iterators are at the end or at the same node.
  * 
  */
-template< typename DataType, class KeyType >
-void BSTree< DataType, KeyType >::countHelper( BSTreeNode* source, int &count ) const
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+bool BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::operator==( const const_iterator& other ) const
 {
-	if( source != NULL )
+	if( path.empty() || other.path.empty() )
 	{
-		countHelper( source->left, count );
-		count++;
-		countHelper( source->right, count );
-	}	
+		return ( path.empty() && other.path.empty() );
+	}
+	
+	return ( path.back() == other.path.back() );
 }
 
 /**
- * Get Height.
- * 
- * This function gets the height of the tree.  It does this by calling
- * the heightHelper function.
+ * Iterator Inequality.
  * 
- * @return The height of the tree.
+ * @return bool true if the iterators are at different items.
  * 
  */
-template< typename DataType, class KeyType >
-int BSTree< DataType, KeyType >::getHeight() const
-{	
-	return heightHelper( root );
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+bool BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::operator!=( const const_iterator& other ) const
+{
+	return !( *this == other );
 }
 
 /**
- * Height Helper.
- * 
- * This function helps the getHeight function get the height of the tree.
- * It does this recursively until the max height of the tree is found.
- * 
- * @pre A tree must exist to get the height.
- * @post The height of the tree is returned.
+ * Iterator Push Left.
  * 
- * @param BSTreeNode pointer source
+ * This function pushes a node and its chain of left children on to path,
+ * which leaves the smallest key of the subtree on top.
  * 
- * @return The hieght is returned.
+ * @param BSTreeNode pointer source, the root of the subtree.
  * 
  */
-template< typename DataType, class KeyType >
-int BSTree< DataType, KeyType >::heightHelper( BSTreeNode* source ) const
+template< typename DataType, class KeyType, class Balance, template< typename > class Allocator, class Instrument >
+void BSTree< DataType, KeyType, Balance, Allocator, Instrument >::const_iterator::pushLeft( BSTreeNode* source )
 {
-	if( source == NULL )
-	{
-		return 0;
-	}
-	else
+	while( source != NULL )
 	{
-		int leftHeight = heightHelper( source->left );
-		int rightHeight = heightHelper( source->right );
-		
-		if( leftHeight > rightHeight )
-		{
-			return ( leftHeight + 1 );
-		}
-		else
-		{
-			return ( rightHeight + 1 );
-		}
+		path.push_back( source );
+		source = source->left;
 	}
 }
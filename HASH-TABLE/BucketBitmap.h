@@ -0,0 +1,80 @@
+// BucketBitmap.h
+
+#ifndef BUCKETBITMAP_H
+#define BUCKETBITMAP_H
+
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+using namespace std;
+
+// One bit per bucket, set while the bucket holds an item.  The bucket
+// policies keep one so that clearing and iterating a sparse table skip
+// empty buckets 64 at a time instead of looking at every bucket.
+class BucketBitmap {
+  public:
+    BucketBitmap(int bucketCount = 0)
+        : words((bucketCount + 63) / 64, 0) {}
+
+    void set(int bucket)
+        { words[bucket >> 6] |= uint64_t(1) << (bucket & 63); }
+    void reset(int bucket)
+        { words[bucket >> 6] &= ~(uint64_t(1) << (bucket & 63)); }
+    bool test(int bucket) const
+        { return (words[bucket >> 6] >> (bucket & 63)) & 1; }
+    void clear()
+        { fill(words.begin(), words.end(), 0); }
+
+    // First set bucket at or after bucket, or -1 if there is none
+    int next(int bucket) const;
+
+    size_t getMemoryBytes() const
+        { return words.capacity() * sizeof(uint64_t); }
+
+  private:
+    static int lowestBit(uint64_t word);
+
+    vector<uint64_t> words;
+};
+
+//--------------------------------------------------------------------
+
+inline int BucketBitmap::next(int bucket) const
+{
+    size_t index = bucket >> 6;
+
+    if (index >= words.size()) {
+        return -1;
+    }
+
+    uint64_t word = words[index] & (~uint64_t(0) << (bucket & 63));
+
+    while (word == 0) {
+        if (++index == words.size()) {
+            return -1;
+        }
+
+        word = words[index];
+    }
+
+    return int(index * 64) + lowestBit(word);
+}
+
+inline int BucketBitmap::lowestBit(uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+
+    while ((word & 1) == 0) {
+        word >>= 1;
+        bit++;
+    }
+
+    return bit;
+#endif
+}
+
+#endif	// ifndef BUCKETBITMAP_H
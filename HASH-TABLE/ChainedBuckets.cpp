@@ -0,0 +1,716 @@
+/**
+ * @file ChainedBuckets.cpp
+ * @author Amardeep Singh
+ * @brief This program stores the buckets of a hash table as an array of
+ * binary search trees.
+*/
+#include "ChainedBuckets.h"
+
+/**
+ * Constructor.
+ * 
+ * The constructor allocates memory to an array of BSTs.  The size is
+ * rounded up to a power of two so that buckets are selected by masking.
+ * 
+ * @pre The buckets do not exist.
+ * @post The buckets are created with the size of initBucketCount.
+ * 
+ * @param Int initBucketCount.
+ * 
+ */
+template <typename DataType, typename KeyType>
+ChainedBuckets<DataType, KeyType>::ChainedBuckets( int initBucketCount )
+{
+	bucketCount = roundUpToPowerOfTwo( initBucketCount );
+	buckets = new Bucket[ bucketCount ];
+	occupied = BucketBitmap( bucketCount );
+}
+
+/**
+ * Copy Constructor.
+ * 
+ * The copy constructor creates new buckets with the trees from the
+ * source buckets.  Only the buckets in use are copied.
+ * 
+ * @pre The buckets do not exist.
+ * @post The buckets are created with the values from the source buckets.
+ * 
+ * @param ChainedBuckets source passed by const reference.
+ * 
+ */
+template <typename DataType, typename KeyType>
+ChainedBuckets<DataType, KeyType>::ChainedBuckets( const ChainedBuckets& source )
+{
+	bucketCount = source.bucketCount;
+	buckets = new Bucket[ bucketCount ];
+	occupied = source.occupied;
+	
+	for( int i = occupied.next( 0 ); i != -1; i = occupied.next( i + 1 ) )
+	{
+		buckets[ i ] = source.buckets[ i ];
+	}
+}
+
+/**
+ * Overloaded assignment operator.
+ * 
+ * The assignment operator replaces the buckets with a copy of the source
+ * buckets.  Nothing is done on self assignment.
+ * 
+ * @pre The buckets exist.
+ * @post The buckets hold a copy of the source buckets.
+ * 
+ * @param ChainedBuckets source passed by const reference
+ * @return Dereferenced this
+ * 
+ */
+template <typename DataType, typename KeyType>
+ChainedBuckets<DataType, KeyType>& ChainedBuckets<DataType, KeyType>::operator=( const ChainedBuckets& source )
+{
+	if( this != &source )
+	{
+		delete[]buckets;
+		
+		bucketCount = source.bucketCount;
+		buckets = new Bucket[ bucketCount ];
+		occupied = source.occupied;
+		
+		for( int i = occupied.next( 0 ); i != -1; i = occupied.next( i + 1 ) )
+		{
+			buckets[ i ] = source.buckets[ i ];
+		}
+	}
+	
+	return *this;
+}
+
+/**
+ * Destructor.
+ * 
+ * The destructor deallocates the array of BSTs.
+ * 
+ * @pre The buckets exist.
+ * @post The buckets are deallocated.
+ * 
+ */
+template <typename DataType, typename KeyType>
+ChainedBuckets<DataType, KeyType>::~ChainedBuckets()
+{
+	delete[]buckets;
+	buckets = NULL;
+}
+
+/**
+ * Insert.
+ * 
+ * The insert function inserts the data item into the BST of the bucket
+ * selected by the hash value.  An item with the same key is replaced.
+ * 
+ * @pre The hash value was computed from the key of newDataItem.
+ * @post The bucket contains the new item.
+ * 
+ * @param unsigned int hashValue.
+ * @param Item newDataItem passed by forwarding reference; it is copied
+ * from if it is an lvalue and moved from if it is an rvalue.
+ * 
+ * @return bool true if the key was not stored before.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename Item>
+bool ChainedBuckets<DataType, KeyType>::insert( unsigned int hashValue, Item&& newDataItem )
+{
+	int bucket = hashToBucket( hashValue, bucketCount - 1 );
+	
+	occupied.set( bucket );
+	return buckets[ bucket ].insertItem( std::forward<Item>( newDataItem ) );
+}
+
+/**
+ * Remove.
+ * 
+ * The remove function removes the item with deleteKey from the BST of the
+ * bucket selected by the hash value.
+ * 
+ * @pre The hash value was computed from deleteKey.
+ * @post If the key was stored then it is removed.
+ * 
+ * @param unsigned int hashValue.
+ * @param KeyType deleteKey passed by const reference.
+ * 
+ * @return bool
+ * 
+ */
+template <typename DataType, typename KeyType>
+bool ChainedBuckets<DataType, KeyType>::remove( unsigned int hashValue, const KeyType& deleteKey )
+{
+	int bucket = hashToBucket( hashValue, bucketCount - 1 );
+	bool removed = buckets[ bucket ].remove( deleteKey );
+	
+	if( buckets[ bucket ].isEmpty() )
+	{
+		occupied.reset( bucket );
+	}
+	
+	return removed;
+}
+
+/**
+ * Find.
+ * 
+ * The find function searches the BST of the bucket selected by the hash
+ * value for searchKey.  The key may be of any type that compares with
+ * KeyType, such as a const char* for string keys.
+ * 
+ * @pre The hash value was computed from searchKey.
+ * @post none
+ * 
+ * @param unsigned int hashValue.
+ * @param LookupKey searchKey passed by const reference.
+ * 
+ * @return A pointer to the stored item, or NULL if the key is not stored.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename LookupKey>
+const DataType* ChainedBuckets<DataType, KeyType>::find( unsigned int hashValue, const LookupKey& searchKey ) const
+{
+	return buckets[ hashToBucket( hashValue, bucketCount - 1 ) ].findItem( searchKey );
+}
+
+/**
+ * Prefetch.
+ * 
+ * This function starts loading the root node of the bucket selected by
+ * the hash value, so that a find issued shortly after does not wait for
+ * it.
+ * 
+ * @pre none
+ * @post none
+ * 
+ * @param unsigned int hashValue.
+ * 
+ * @note ALGORITHM: Reading the root pointer may itself miss the cache, but
+ * nothing waits on it except the prefetch, so the reads for a batch of
+ * hash values overlap with each other.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void ChainedBuckets<DataType, KeyType>::prefetch( unsigned int hashValue ) const
+{
+	buckets[ hashToBucket( hashValue, bucketCount - 1 ) ].prefetchRoot();
+}
+
+/**
+ * Clear.
+ * 
+ * This function clears every BST in the buckets.  Only the buckets in
+ * use are visited, so clearing a sparse table costs little more than the
+ * number of items.
+ * 
+ * @pre The buckets contain values.
+ * @post The buckets are empty.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void ChainedBuckets<DataType, KeyType>::clear()
+{
+	for( int i = occupied.next( 0 ); i != -1; i = occupied.next( i + 1 ) )
+	{
+		buckets[ i ].clear();
+	}
+	
+	occupied.clear();
+}
+
+/**
+ * isEmpty
+ * 
+ * This function checks whether any bucket is in use.
+ * 
+ * @return bool.
+ * 
+ */
+template <typename DataType, typename KeyType>
+bool ChainedBuckets<DataType, KeyType>::isEmpty() const
+{
+	return ( occupied.next( 0 ) == -1 );
+}
+
+/**
+ * Get Bucket Count.
+ * 
+ * @return The number of buckets.
+ * 
+ */
+template <typename DataType, typename KeyType>
+int ChainedBuckets<DataType, KeyType>::getBucketCount() const
+{
+	return bucketCount;
+}
+
+/**
+ * Write Keys.
+ * 
+ * This function writes out the keys stored in one bucket in ascending
+ * order.  It is used by showStructure.
+ * 
+ * @param int bucket.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void ChainedBuckets<DataType, KeyType>::writeKeys( int bucket ) const
+{
+	buckets[ bucket ].writeKeys();
+}
+
+/**
+ * Take Item.
+ * 
+ * This function removes one item from a bucket and returns it by
+ * reference.  It is used to move the items into a larger table.
+ * 
+ * @pre none
+ * @post If the bucket was not empty then it holds one item less.
+ * 
+ * @param int bucket.
+ * @param DataType returnItem passed by reference.
+ * 
+ * @return bool false if the bucket was empty.
+ * 
+ */
+template <typename DataType, typename KeyType>
+bool ChainedBuckets<DataType, KeyType>::takeItem( int bucket, DataType& returnItem )
+{
+	bool taken = buckets[ bucket ].takeRoot( returnItem );
+	
+	if( buckets[ bucket ].isEmpty() )
+	{
+		occupied.reset( bucket );
+	}
+	
+	return taken;
+}
+
+/**
+ * Erase If.
+ * 
+ * This function removes every item for which pred returns true, visiting
+ * only the buckets in use.
+ * 
+ * @pre pred takes a const DataType& and returns bool.
+ * @post No item left in the buckets satisfies pred.
+ * 
+ * @param Predicate pred passed by reference.
+ * 
+ * @return The number of items removed.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename Predicate>
+int ChainedBuckets<DataType, KeyType>::eraseIf( Predicate& pred )
+{
+	int removed = 0;
+	
+	for( int i = occupied.next( 0 ); i != -1; i = occupied.next( i + 1 ) )
+	{
+		removed += buckets[ i ].eraseItems( pred );
+		
+		if( buckets[ i ].isEmpty() )
+		{
+			occupied.reset( i );
+		}
+	}
+	
+	return removed;
+}
+
+/**
+ * First.
+ * 
+ * This function starts an iteration over the items.
+ * 
+ * @pre none
+ * @post cursor is at the first item.
+ * 
+ * @param Cursor cursor passed by reference.
+ * 
+ * @return A pointer to the first item, or NULL if there are no items.
+ * 
+ */
+template <typename DataType, typename KeyType>
+const DataType* ChainedBuckets<DataType, KeyType>::first( Cursor& cursor ) const
+{
+	return firstInBucket( cursor, occupied.next( 0 ) );
+}
+
+/**
+ * Next.
+ * 
+ * This function moves an iteration on to the next item.
+ * 
+ * @pre cursor is at an item.
+ * @post cursor is at the next item.
+ * 
+ * @param Cursor cursor passed by reference.
+ * 
+ * @return A pointer to the next item, or NULL if there are no more items.
+ * 
+ * @note ALGORITHM: The top of the path is the current node.  It is popped
+ * and the leftmost branch of its right subtree is pushed, which leaves
+ * the next larger key on top.  Once the path is empty the iteration moves
+ * on to the next bucket in use.
+ * 
+ */
+template <typename DataType, typename KeyType>
+const DataType* ChainedBuckets<DataType, KeyType>::next( Cursor& cursor ) const
+{
+	typename Bucket::Node* node = cursor.path.back()->right;
+	
+	cursor.path.pop_back();
+	
+	for( ; node != NULL; node = node->left )
+	{
+		cursor.path.push_back( node );
+	}
+	
+	if( !cursor.path.empty() )
+	{
+		return &cursor.path.back()->dataItem;
+	}
+	
+	return firstInBucket( cursor, occupied.next( cursor.bucket + 1 ) );
+}
+
+/**
+ * First In Bucket.
+ * 
+ * This function moves an iteration to the smallest key of a bucket.
+ * 
+ * @param Cursor cursor passed by reference.
+ * @param int bucket, a bucket in use or -1.
+ * 
+ * @return A pointer to the item, or NULL if bucket is -1.
+ * 
+ */
+template <typename DataType, typename KeyType>
+const DataType* ChainedBuckets<DataType, KeyType>::firstInBucket( Cursor& cursor, int bucket ) const
+{
+	cursor.bucket = bucket;
+	cursor.path.clear();
+	
+	if( bucket == -1 )
+	{
+		return NULL;
+	}
+	
+	for( typename Bucket::Node* node = buckets[ bucket ].getRoot(); node != NULL; node = node->left )
+	{
+		cursor.path.push_back( node );
+	}
+	
+	return &cursor.path.back()->dataItem;
+}
+
+/**
+ * Default Max Load Factor.
+ * 
+ * @return The number of items per bucket that a HashTable using chained
+ * buckets lets itself reach before it grows.
+ * 
+ */
+template <typename DataType, typename KeyType>
+double ChainedBuckets<DataType, KeyType>::defaultMaxLoadFactor()
+{
+	return 1.0;
+}
+
+/**
+ * Get Bucket Lengths.
+ * 
+ * This function appends the number of items in each bucket to lengths.
+ * 
+ * @param vector<int> lengths passed by reference.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void ChainedBuckets<DataType, KeyType>::getBucketLengths( vector<int>& lengths ) const
+{
+	for( int i = 0; i < bucketCount; i++ )
+	{
+		lengths.push_back( buckets[ i ].getCount() );
+	}
+}
+
+/**
+ * Get Bucket Heights.
+ * 
+ * This function appends the height of each bucket's tree to heights.
+ * 
+ * @param vector<int> heights passed by reference.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void ChainedBuckets<DataType, KeyType>::getBucketHeights( vector<int>& heights ) const
+{
+	for( int i = 0; i < bucketCount; i++ )
+	{
+		heights.push_back( buckets[ i ].getHeight() );
+	}
+}
+
+/**
+ * Get Hit Probes.
+ * 
+ * This function appends, for every stored item, the number of tree nodes
+ * a retrieve of its key visits.
+ * 
+ * @param vector<int> probes passed by reference.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void ChainedBuckets<DataType, KeyType>::getHitProbes( vector<int>& probes ) const
+{
+	for( int i = 0; i < bucketCount; i++ )
+	{
+		buckets[ i ].getHitProbes( probes );
+	}
+}
+
+/**
+ * Probe Count.
+ * 
+ * @param unsigned int hashValue.
+ * @param KeyType searchKey passed by const reference.
+ * 
+ * @return The number of tree nodes a retrieve of searchKey visits.
+ * 
+ */
+template <typename DataType, typename KeyType>
+int ChainedBuckets<DataType, KeyType>::probeCount( unsigned int hashValue, const KeyType& searchKey ) const
+{
+	return buckets[ hashToBucket( hashValue, bucketCount - 1 ) ].probeCount( searchKey );
+}
+
+/**
+ * Get Memory Bytes.
+ * 
+ * @return The bytes used by the bucket array and the tree nodes, not
+ * counting memory the items own themselves or allocator overhead.
+ * 
+ */
+template <typename DataType, typename KeyType>
+size_t ChainedBuckets<DataType, KeyType>::getMemoryBytes() const
+{
+	size_t bytes = sizeof( *this ) + bucketCount * sizeof( Bucket ) + occupied.getMemoryBytes();
+	
+	for( int i = 0; i < bucketCount; i++ )
+	{
+		bytes += buckets[ i ].getCount() * sizeof( typename Bucket::Node );
+	}
+	
+	return bytes;
+}
+
+/**
+ * Bucket Insert Item.
+ * 
+ * This function inserts a data item into the bucket's tree, replacing
+ * the item with the same key if there is one.
+ * 
+ * @pre none
+ * @post The tree contains the new item.
+ * 
+ * @param Item newDataItem passed by forwarding reference; it is copied
+ * from if it is an lvalue and moved from if it is an rvalue.
+ * 
+ * @return bool true if the key was not in the tree before.
+ * 
+ * @note ALGORITHM: An rvalue is moved into the tree by the BSTree move
+ * insert, so its members are never copied; an lvalue goes through the
+ * const reference insert, which only assigns it.  The tree keeps its node
+ * count, so comparing the count before and after shows whether a node
+ * was added.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename Item>
+bool ChainedBuckets<DataType, KeyType>::Bucket::insertItem( Item&& newDataItem )
+{
+	int before = this->getCount();
+	
+	this->insert( std::forward<Item>( newDataItem ) );
+	return ( this->getCount() != before );
+}
+
+/**
+ * Bucket Take Root.
+ * 
+ * This function removes the item at the root of the bucket's tree and
+ * moves it out by reference.
+ * 
+ * @pre none
+ * @post If the tree was not empty then it holds one item less.
+ * 
+ * @param DataType returnItem passed by reference.
+ * 
+ * @return bool false if the tree was empty.
+ * 
+ * @note ALGORITHM: The root's key is copied, because the BSTree move
+ * remove moves the item, key and all, out of the node.
+ * 
+ */
+template <typename DataType, typename KeyType>
+bool ChainedBuckets<DataType, KeyType>::Bucket::takeRoot( DataType& returnItem )
+{
+	if( this->root == NULL )
+	{
+		return false;
+	}
+	
+	KeyType rootKey = this->root->dataItem.getKey();
+	
+	return this->remove( rootKey, returnItem );
+}
+
+/**
+ * Bucket Find Item.
+ * 
+ * This function walks down the bucket's tree looking for searchKey.
+ * 
+ * @param LookupKey searchKey passed by const reference.
+ * 
+ * @return A pointer to the item with searchKey, or NULL.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename LookupKey>
+const DataType* ChainedBuckets<DataType, KeyType>::Bucket::findItem( const LookupKey& searchKey ) const
+{
+	for( Node* source = this->root; source != NULL; )
+	{
+		if( source->dataItem.getKey() == searchKey )
+		{
+			return &source->dataItem;
+		}
+		
+		source = ( searchKey < source->dataItem.getKey() ) ? source->left : source->right;
+	}
+	
+	return NULL;
+}
+
+/**
+ * Bucket Prefetch Root.
+ * 
+ * This function starts loading the root node of the bucket, if it has one.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void ChainedBuckets<DataType, KeyType>::Bucket::prefetchRoot() const
+{
+	if( this->root != NULL )
+	{
+		prefetchForRead( this->root );
+	}
+}
+
+/**
+ * Bucket Get Root.
+ * 
+ * @return The root node of the bucket's tree, or NULL if it is empty.
+ * 
+ */
+template <typename DataType, typename KeyType>
+typename ChainedBuckets<DataType, KeyType>::Bucket::Node* ChainedBuckets<DataType, KeyType>::Bucket::getRoot() const
+{
+	return this->root;
+}
+
+/**
+ * Bucket Erase Items.
+ * 
+ * This function removes every item of the bucket's tree for which pred
+ * returns true.
+ * 
+ * @param Predicate pred passed by reference.
+ * 
+ * @return The number of items removed.
+ * 
+ * @note ALGORITHM: The keys of the matching items are collected by an
+ * in-order walk first, and then removed one by one, so every item is
+ * tested exactly once and the walk never sees a tree that is changing.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename Predicate>
+int ChainedBuckets<DataType, KeyType>::Bucket::eraseItems( Predicate& pred )
+{
+	vector<KeyType> doomed;
+	
+	for( typename Bucket::const_iterator item = this->begin(); item != this->end(); ++item )
+	{
+		if( pred( *item ) )
+		{
+			doomed.push_back( item->getKey() );
+		}
+	}
+	
+	for( unsigned int i = 0; i < doomed.size(); i++ )
+	{
+		this->remove( doomed[ i ] );
+	}
+	
+	return doomed.size();
+}
+
+/**
+ * Bucket Probe Count.
+ * 
+ * @param KeyType searchKey passed by const reference.
+ * 
+ * @return The number of nodes visited while searching for searchKey.
+ * 
+ */
+template <typename DataType, typename KeyType>
+int ChainedBuckets<DataType, KeyType>::Bucket::probeCount( const KeyType& searchKey ) const
+{
+	int probes = 0;
+	
+	for( Node* source = this->root; source != NULL; )
+	{
+		probes++;
+		
+		if( source->dataItem.getKey() == searchKey )
+		{
+			break;
+		}
+		
+		source = ( searchKey < source->dataItem.getKey() ) ? source->left : source->right;
+	}
+	
+	return probes;
+}
+
+/**
+ * Bucket Get Hit Probes.
+ * 
+ * This function appends the depth of every node in the bucket's tree,
+ * counting the root as one, to probes.
+ * 
+ * @param vector<int> probes passed by reference.
+ * 
+ * @note ALGORITHM: The depths come from the tree's inorderHelper, which
+ * walks with a stack of its own rather than by recursion, so a bucket
+ * that a poor hash has made as tall as it has items cannot overflow the
+ * call stack.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void ChainedBuckets<DataType, KeyType>::Bucket::getHitProbes( vector<int>& probes ) const
+{
+	this->inorderHelper( this->root, [&probes]( Node*, int depth )
+	{
+		probes.push_back( depth );
+	} );
+}
@@ -0,0 +1,101 @@
+// ChainedBuckets.h
+
+#ifndef CHAINEDBUCKETS_H
+#define CHAINEDBUCKETS_H
+
+#include <stdexcept>
+#include <iostream>
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+#include "HashFunctions.h"
+#include "BucketBitmap.h"
+#include "BSTree.cpp"
+
+// Bucket storage policy for HashTable: every bucket is a binary search
+// tree that holds all of the data items hashing to it.
+template <typename DataType, typename KeyType>
+class ChainedBuckets {
+  public:
+    ChainedBuckets(int initBucketCount);
+    ChainedBuckets(const ChainedBuckets& other);
+    ChainedBuckets& operator=(const ChainedBuckets& other);
+
+    ~ChainedBuckets();
+
+    template <typename Item>
+    bool insert(unsigned int hashValue, Item&& newDataItem);
+    bool remove(unsigned int hashValue, const KeyType& deleteKey);
+    template <typename LookupKey>
+    const DataType* find(unsigned int hashValue, const LookupKey& searchKey) const;
+    void prefetch(unsigned int hashValue) const;
+    void clear();
+
+    bool isEmpty() const;
+
+    int getBucketCount() const;
+    void writeKeys(int bucket) const;
+
+    bool takeItem(int bucket, DataType& returnItem);
+
+    // Removes every item for which pred(item) is true
+    template <typename Predicate>
+    int eraseIf(Predicate& pred);
+
+    // Iteration over the items: first() and next() return NULL at the end
+    class Cursor;
+    const DataType* first(Cursor& cursor) const;
+    const DataType* next(Cursor& cursor) const;
+
+    static double defaultMaxLoadFactor();
+
+    // Statistics: the vector functions append one entry per bucket/item
+    void getBucketLengths(vector<int>& lengths) const;
+    void getBucketHeights(vector<int>& heights) const;
+    void getHitProbes(vector<int>& probes) const;
+    int probeCount(unsigned int hashValue, const KeyType& searchKey) const;
+    size_t getMemoryBytes() const;
+
+  private:
+    // A bucket is a BSTree that can also report whether an insert added a
+    // new key and hand its items out one at a time for rehashing.  Most
+    // buckets hold one or two items, so their nodes come straight from
+    // the heap rather than from a NodePool block per bucket.
+    class Bucket : public BSTree<DataType, KeyType, Unbalanced, HeapNodes> {
+      public:
+	typedef typename BSTree<DataType, KeyType, Unbalanced, HeapNodes>::BSTreeNode Node;
+
+	template <typename Item>
+	bool insertItem(Item&& newDataItem);
+	bool takeRoot(DataType& returnItem);
+	template <typename LookupKey>
+	const DataType* findItem(const LookupKey& searchKey) const;
+	void prefetchRoot() const;
+	Node* getRoot() const;
+	template <typename Predicate>
+	int eraseItems(Predicate& pred);
+	int probeCount(const KeyType& searchKey) const;
+	void getHitProbes(vector<int>& probes) const;
+    };
+
+    const DataType* firstInBucket(Cursor& cursor, int bucket) const;
+
+    int bucketCount;
+    Bucket* buckets;
+    BucketBitmap occupied;		// Buckets whose tree is not empty
+
+  public:
+    // Position of an iteration.  The items of each bucket are visited in
+    // key order using a stack of the nodes still to be visited.
+    class Cursor {
+      private:
+	friend class ChainedBuckets;
+
+	int bucket;
+	vector<typename Bucket::Node*> path;
+    };
+};
+
+#endif	// ifndef CHAINEDBUCKETS_H
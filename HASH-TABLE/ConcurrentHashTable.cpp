@@ -0,0 +1,238 @@
+/**
+ * @file ConcurrentHashTable.cpp
+ * @author Amardeep Singh
+ * @brief This program creates a hash table that many threads can use at
+ * once by splitting it into shards with their own reader-writer locks.
+*/
+#include "ConcurrentHashTable.h"
+
+/**
+ * Shard constructor.
+ * 
+ * @param int initTableSize, the bucket count of the shard's table.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::Shard::Shard( int initTableSize )
+	: table( initTableSize )
+{
+}
+
+/**
+ * Constructor.
+ * 
+ * The constructor creates the shards.  The shard count is rounded up to a
+ * power of two and the table size is split evenly between the shards.
+ * 
+ * @pre A hash table does not exist
+ * @post The hash table is created with about initTableSize buckets.
+ * 
+ * @param int initTableSize.
+ * @param int initShardCount.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::ConcurrentHashTable( int initTableSize, int initShardCount )
+{
+	shardCount = roundUpToPowerOfTwo( initShardCount );
+	shardBits = 0;
+	
+	while( ( 1 << shardBits ) < shardCount )
+	{
+		shardBits++;
+	}
+	
+	shards = new Shard*[ shardCount ];
+	
+	for( int i = 0; i < shardCount; i++ )
+	{
+		shards[ i ] = new Shard( initTableSize / shardCount );
+	}
+}
+
+/**
+ * Destructor.
+ * 
+ * The destructor deallocates the shards.  No other thread may be using
+ * the table.
+ * 
+ * @pre A hash table exists.
+ * @post A hash table is deallocated.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::~ConcurrentHashTable()
+{
+	for( int i = 0; i < shardCount; i++ )
+	{
+		delete shards[ i ];
+	}
+	
+	delete[]shards;
+	shards = NULL;
+}
+
+/**
+ * Insert.
+ * 
+ * The insert function inserts a new data item into its shard while
+ * holding the shard's lock exclusively.
+ * 
+ * @pre none
+ * @post The hash table contains the new item
+ * 
+ * @param DataType newDataItem passed by const reference.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::insert( const DataType& newDataItem )
+{
+	Shard& shard = shardFor( newDataItem.getKey() );
+	unique_lock<shared_mutex> guard( shard.lock );
+	
+	shard.table.insert( newDataItem );
+}
+
+/**
+ * Remove.
+ * 
+ * The remove function removes the item with deleteKey from its shard
+ * while holding the shard's lock exclusively.
+ * 
+ * @pre none
+ * @post If the key was stored then it is removed.
+ * 
+ * @param KeyType deleteKey passed by const reference.
+ * 
+ * @return bool
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+bool ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::remove( const KeyType& deleteKey )
+{
+	Shard& shard = shardFor( deleteKey );
+	unique_lock<shared_mutex> guard( shard.lock );
+	
+	return shard.table.remove( deleteKey );
+}
+
+/**
+ * Retrieve.
+ * 
+ * The retrieve function searches the shard of searchKey while holding the
+ * shard's lock shared, so any number of lookups proceed together.
+ * 
+ * @pre none
+ * @post If the key is stored then the item is returned by reference.
+ * 
+ * @param KeyType searchKey passed by const reference.
+ * @param DataType returnItem passed by reference.
+ * 
+ * @return bool
+ * 
+ * @note Readers still take the shard lock.  A seqlock or other optimistic
+ * read would let a reader copy an item while a writer is changing it or
+ * growing the buckets under it, which is not safe for items that own
+ * memory, such as the strings of a password entry.  A shared lock costs one
+ * atomic operation on an uncontended line.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+bool ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::retrieve( const KeyType& searchKey, DataType& returnItem ) const
+{
+	Shard& shard = shardFor( searchKey );
+	shared_lock<shared_mutex> guard( shard.lock );
+	
+	return shard.table.retrieve( searchKey, returnItem );
+}
+
+/**
+ * Clear.
+ * 
+ * This function clears the shards one at a time.  Items inserted by other
+ * threads while it runs may survive.
+ * 
+ * @pre none
+ * @post Every shard has been cleared.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::clear()
+{
+	for( int i = 0; i < shardCount; i++ )
+	{
+		unique_lock<shared_mutex> guard( shards[ i ]->lock );
+		
+		shards[ i ]->table.clear();
+	}
+}
+
+/**
+ * isEmpty
+ * 
+ * @return bool if every shard was empty when it was checked.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+bool ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::isEmpty() const
+{
+	return ( getCount() == 0 );
+}
+
+/**
+ * Get Count.
+ * 
+ * This function adds up the counts of the shards, locking one at a time.
+ * 
+ * @return The number of items in the hash table.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+int ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::getCount() const
+{
+	int count = 0;
+	
+	for( int i = 0; i < shardCount; i++ )
+	{
+		shared_lock<shared_mutex> guard( shards[ i ]->lock );
+		
+		count += shards[ i ]->table.getCount();
+	}
+	
+	return count;
+}
+
+/**
+ * Get Shard Count.
+ * 
+ * @return The number of shards.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+int ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::getShardCount() const
+{
+	return shardCount;
+}
+
+/**
+ * Shard For.
+ * 
+ * This function selects the shard of a key from the top bits of a second
+ * multiply of the key's hash value.  The buckets inside a shard are
+ * selected from the folded low bits, so the two choices stay independent.
+ * 
+ * @param KeyType key passed by const reference.
+ * 
+ * @return The shard that holds key.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+typename ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::Shard& ConcurrentHashTable<DataType, KeyType, Buckets, Hasher>::shardFor( const KeyType& key ) const
+{
+	if( shardBits == 0 )
+	{
+		return *shards[ 0 ];
+	}
+	
+	return *shards[ ( hasher( key ) * 0x85EBCA6Bu ) >> ( 32 - shardBits ) ];
+}
@@ -0,0 +1,60 @@
+// ConcurrentHashTable.h
+
+#ifndef CONCURRENTHASHTABLE_H
+#define CONCURRENTHASHTABLE_H
+
+#include <stdexcept>
+#include <iostream>
+#include <shared_mutex>
+#include <mutex>
+
+using namespace std;
+
+#include "HashTable.cpp"
+
+// Thread safe hash table.  The items are spread over a power of two number
+// of shards, each an ordinary HashTable guarded by its own reader-writer
+// lock, so lookups in any shard and writes to different shards all run in
+// parallel.  Shards are aligned to cache lines so that threads working on
+// neighbouring shards do not fight over the same line.
+template <typename DataType, typename KeyType,
+          template <typename, typename> class Buckets = ChainedBuckets,
+          typename Hasher = DataTypeHash<DataType, KeyType> >
+class ConcurrentHashTable {
+  public:
+    static const int DEFAULT_SHARD_COUNT = 64;
+
+    ConcurrentHashTable(int initTableSize, int initShardCount = DEFAULT_SHARD_COUNT);
+    ~ConcurrentHashTable();
+
+    void insert(const DataType& newDataItem);
+    bool remove(const KeyType& deleteKey);
+    bool retrieve(const KeyType& searchKey, DataType& returnItem) const;
+    void clear();
+
+    bool isEmpty() const;
+    int getCount() const;
+    int getShardCount() const;
+
+  private:
+    // Not copyable: a copy could not be taken atomically across shards.
+    ConcurrentHashTable(const ConcurrentHashTable& other);
+    ConcurrentHashTable& operator=(const ConcurrentHashTable& other);
+
+    class alignas(64) Shard {
+      public:
+	Shard(int initTableSize);
+
+	mutable shared_mutex lock;
+	HashTable<DataType, KeyType, Buckets, Hasher> table;
+    };
+
+    Shard& shardFor(const KeyType& key) const;
+
+    int shardCount;
+    int shardBits;
+    Shard** shards;
+    Hasher hasher;
+};
+
+#endif	// ifndef CONCURRENTHASHTABLE_H
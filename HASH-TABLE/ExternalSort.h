@@ -0,0 +1,76 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 9                                    ExternalSort.h
+//
+//  Class declaration for sorting more data items than fit in memory,
+//  used by BSTree::buildFromUnsorted
+//
+//--------------------------------------------------------------------
+
+#ifndef EXTERNALSORT_H
+#define EXTERNALSORT_H
+
+#include <stdexcept>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <type_traits>
+
+using namespace std;
+
+// Items are added in any order and then read back in ascending key
+// order, one item per key; of several items with the same key the last
+// one added is kept.  Items are collected into runs of runItems.  While
+// everything fits in one run it is sorted in memory; otherwise every
+// full run is sorted and written to a temporary file, and the runs are
+// merged as the items are read back.  Run files hold the items' bytes,
+// so DataType must always be trivially copyable: whether a run is
+// spilled is only known at run time, so add() is checked for it even
+// when every item would fit in one run.
+template < typename DataType >      // DataType : item with getKey()
+class ExternalSort
+{
+  public:
+
+    static const int DEFAULT_RUN_ITEMS = 1 << 20;
+
+    // Constructor
+    ExternalSort ( int runItems = DEFAULT_RUN_ITEMS );
+
+    // Destructor
+    ~ExternalSort ();                   // Removes the run files
+
+    void add ( const DataType& item );  // Before finish
+    int finish ();                      // Returns the number of keys
+    const DataType& next ();            // After finish, once per key;
+                                        //   good until the next call
+    bool good () const;                 // False if a run file could not
+                                        //   be written or read
+
+  private:
+
+    ExternalSort ( const ExternalSort& other );   // Not copyable
+    ExternalSort& operator= ( const ExternalSort& other );
+
+    static bool keyLess ( const DataType& a, const DataType& b );
+    void sortRun ();
+    void writeRun ();
+    bool readHead ( int file );
+    bool headAfter ( int a, int b ) const;
+    void startMerge ();
+    bool mergeNext ();
+
+    int runItems;                   // Items per run
+    vector<DataType> run;           // Run being filled, or all items
+                                    //   when there are no run files
+    unsigned int position;          // Next item of run to read back
+    vector<FILE*> files;            // Sorted run files, oldest first
+    vector<DataType> heads;         // Next item of each run file
+    vector<int> heap;               // Run files with items left, by
+                                    //   the key of their head
+    DataType current;               // Item last returned by next()
+    bool failed;
+};
+
+#endif	// define EXTERNALSORT_H
@@ -0,0 +1,193 @@
+// HashFunctions.h
+
+#ifndef HASHFUNCTIONS_H
+#define HASHFUNCTIONS_H
+
+#include <string>
+#include <cstring>
+#include <stdint.h>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+using namespace std;
+
+//--------------------------------------------------------------------
+//
+// Hashers for the Hasher parameter of HashTable.  A hasher is a function
+// object that maps a key to an unsigned int hash value.
+//
+//--------------------------------------------------------------------
+
+// Calls the hash() function of the data item, which is how the lab data
+// items have always been hashed.  One data item is default constructed
+// per table so that hash() may be either static or a member function.
+template <typename DataType, typename KeyType>
+class DataTypeHash {
+  public:
+    unsigned int operator()(const KeyType& key) const
+        { return sample.hash(key); }
+
+  private:
+    DataType sample;
+};
+
+// Fast string hash in the style of wyhash.  The bytes are read eight at a
+// time and folded with 64 x 64 -> 128 bit multiplies, so short keys such
+// as user names take only a handful of instructions.
+class StringHash {
+  public:
+    unsigned int operator()(const string& key) const
+        { return fold(hashBytes(key.data(), key.length())); }
+    unsigned int operator()(const char* key) const
+        { return fold(hashBytes(key, strlen(key))); }
+    unsigned int operator()(const char* key, size_t length) const
+        { return fold(hashBytes(key, length)); }
+#if __cplusplus >= 201703L
+    unsigned int operator()(string_view key) const
+        { return fold(hashBytes(key.data(), key.length())); }
+#endif
+
+    static uint64_t hashBytes(const char* bytes, size_t length);
+
+  private:
+    static uint64_t mix(uint64_t a, uint64_t b);
+    static uint64_t read8(const char* p);
+    static uint64_t read4(const char* p);
+    static unsigned int fold(uint64_t h)
+        { return (unsigned int)(h ^ (h >> 32)); }
+};
+
+// Integer mixer (the splitmix64 finalizer) for integral keys such as
+// account numbers, where the key itself is a poor hash value.
+class IntegerHash {
+  public:
+    template <typename IntegerType>
+    unsigned int operator()(const IntegerType& key) const
+    {
+        uint64_t x = (uint64_t)key;
+
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+
+        return (unsigned int)(x ^ (x >> 32));
+    }
+};
+
+// Maps a hash value onto one of mask + 1 buckets, where the bucket count
+// is a power of two.  The multiply and fold bring the high bits of the
+// hash value down into the masked bits, so weak hashes that only vary in
+// their high or low bits still spread over the buckets.
+inline unsigned int hashToBucket(unsigned int hashValue, unsigned int mask)
+{
+    hashValue *= 0x9E3779B1u;
+    return (hashValue ^ (hashValue >> 16)) & mask;
+}
+
+// Smallest power of two that is not less than count, and at least one.
+inline int roundUpToPowerOfTwo(int count)
+{
+    int size = 1;
+
+    while (size < count) {
+        size *= 2;
+    }
+
+    return size;
+}
+
+// Asks the processor to start loading the cache line at address without
+// waiting for it.  Compilers without the builtin simply skip the hint.
+inline void prefetchForRead(const void* address)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+//--------------------------------------------------------------------
+
+inline uint64_t StringHash::mix(uint64_t a, uint64_t b)
+{
+    __uint128_t product = (__uint128_t)a * b;
+
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+}
+
+inline uint64_t StringHash::read8(const char* p)
+{
+    uint64_t value;
+
+    memcpy(&value, p, 8);
+    return value;
+}
+
+inline uint64_t StringHash::read4(const char* p)
+{
+    uint32_t value;
+
+    memcpy(&value, p, 4);
+    return value;
+}
+
+inline uint64_t StringHash::hashBytes(const char* bytes, size_t length)
+{
+    const uint64_t s0 = 0xa0761d6478bd642fULL,
+                   s1 = 0xe7037ed1a0b428dbULL,
+                   s2 = 0x8ebc6af09c88c6e3ULL,
+                   s3 = 0x589965cc75374cc3ULL;
+    const char* p = bytes;
+    uint64_t seed = s0;
+    uint64_t a, b;
+
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t middle = (length >> 3) << 2;
+
+            a = (read4(p) << 32) | read4(p + middle);
+            b = (read4(p + length - 4) << 32) | read4(p + length - 4 - middle);
+        } else if (length > 0) {
+            a = ((uint64_t)(unsigned char)p[0] << 16)
+              | ((uint64_t)(unsigned char)p[length >> 1] << 8)
+              | (uint64_t)(unsigned char)p[length - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t remaining = length;
+
+        if (remaining > 48) {
+            uint64_t seed1 = seed,
+                     seed2 = seed;
+
+            do {
+                seed = mix(read8(p) ^ s1, read8(p + 8) ^ seed);
+                seed1 = mix(read8(p + 16) ^ s2, read8(p + 24) ^ seed1);
+                seed2 = mix(read8(p + 32) ^ s3, read8(p + 40) ^ seed2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (remaining > 16) {
+            seed = mix(read8(p) ^ s1, read8(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+
+        a = read8(p + remaining - 16);
+        b = read8(p + remaining - 8);
+    }
+
+    return mix(s1 ^ length, mix(a ^ s1, b ^ seed));
+}
+
+#endif	// ifndef HASHFUNCTIONS_H
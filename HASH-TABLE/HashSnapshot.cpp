@@ -0,0 +1,334 @@
+/**
+ * @file HashSnapshot.cpp
+ * @author Amardeep Singh
+ * @brief This program writes hash tables of strings to snapshot files and
+ * searches them in place through a read-only memory mapping.
+*/
+#include "HashSnapshot.h"
+
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+const char HashSnapshot::MAGIC[8] = { 'H', 'S', 'N', 'A', 'P', '0', '1', '\n' };
+
+/**
+ * Constructor.
+ * 
+ * The snapshot starts out closed.
+ * 
+ */
+HashSnapshot::HashSnapshot()
+{
+	mapping = NULL;
+	mappingLength = 0;
+	header = NULL;
+	slots = NULL;
+	bytes = NULL;
+}
+
+/**
+ * Destructor.
+ * 
+ * The destructor unmaps the file if it is open.
+ * 
+ */
+HashSnapshot::~HashSnapshot()
+{
+	close();
+}
+
+/**
+ * Open.
+ * 
+ * This function maps a snapshot file read-only and checks that its header
+ * matches its size.  Any snapshot that was already open is closed.
+ * 
+ * @pre none
+ * @post If the file is a valid snapshot then it is open.
+ * 
+ * @param const char* fileName.
+ * 
+ * @return bool false if the file could not be mapped or is not valid.
+ * 
+ * @note ALGORITHM: After the header, every slot is checked once, so that
+ * find can trust what it reads: the key and value of each used slot must
+ * lie inside the bytes, the used slots must add up to the item count, and
+ * at least one slot must be empty so that every probe sequence ends.  A
+ * truncated or corrupt file is rejected here rather than read out of
+ * bounds later.
+ * 
+ */
+bool HashSnapshot::open( const char* fileName )
+{
+	struct stat status;
+	int fd;
+	
+	close();
+	
+	fd = ::open( fileName, O_RDONLY );
+	
+	if( fd < 0 )
+	{
+		return false;
+	}
+	
+	if( fstat( fd, &status ) != 0 || size_t( status.st_size ) < sizeof( Header ) )
+	{
+		::close( fd );
+		return false;
+	}
+	
+	mappingLength = status.st_size;
+	mapping = mmap( NULL, mappingLength, PROT_READ, MAP_SHARED, fd, 0 );
+	::close( fd );
+	
+	if( mapping == MAP_FAILED )
+	{
+		mapping = NULL;
+		mappingLength = 0;
+		return false;
+	}
+	
+	header = static_cast<const Header*>( mapping );
+	
+	uint64_t slotBytes = uint64_t( header->slotCount ) * sizeof( Slot );
+	
+	if( memcmp( header->magic, MAGIC, sizeof( MAGIC ) ) != 0
+	    || header->slotCount == 0
+	    || ( header->slotCount & ( header->slotCount - 1 ) ) != 0
+	    || slotBytes > mappingLength - sizeof( Header )
+	    || header->byteCount != mappingLength - sizeof( Header ) - slotBytes )
+	{
+		close();
+		return false;
+	}
+	
+	slots = reinterpret_cast<const Slot*>( static_cast<const char*>( mapping ) + sizeof( Header ) );
+	bytes = static_cast<const char*>( mapping ) + sizeof( Header ) + slotBytes;
+	
+	uint32_t used = 0;
+	
+	for( uint32_t i = 0; i < header->slotCount; i++ )
+	{
+		if( slots[ i ].keyLength == EMPTY_SLOT )
+		{
+			continue;
+		}
+		
+		if( uint64_t( slots[ i ].offset ) + slots[ i ].keyLength + slots[ i ].valueLength > header->byteCount )
+		{
+			close();
+			return false;
+		}
+		
+		used++;
+	}
+	
+	if( used != header->itemCount || used == header->slotCount )
+	{
+		close();
+		return false;
+	}
+	
+	return true;
+}
+
+/**
+ * Close.
+ * 
+ * This function unmaps the snapshot file.
+ * 
+ * @pre none
+ * @post The snapshot is closed.
+ * 
+ */
+void HashSnapshot::close()
+{
+	if( mapping != NULL )
+	{
+		munmap( mapping, mappingLength );
+	}
+	
+	mapping = NULL;
+	mappingLength = 0;
+	header = NULL;
+	slots = NULL;
+	bytes = NULL;
+}
+
+/**
+ * isOpen
+ * 
+ * @return bool true if a snapshot file is mapped.
+ * 
+ */
+bool HashSnapshot::isOpen() const
+{
+	return ( mapping != NULL );
+}
+
+/**
+ * Find.
+ * 
+ * This function searches the mapped slots for a key.  The value is
+ * returned as a pointer into the mapping, so nothing is copied.
+ * 
+ * @pre none
+ * @post If the key is stored then value points to its bytes, which stay
+ * valid until the snapshot is closed.
+ * 
+ * @param const char* key.
+ * @param size_t keyLength.
+ * @param const char* value passed by reference.
+ * @param size_t valueLength passed by reference.
+ * 
+ * @return bool
+ * 
+ */
+bool HashSnapshot::find( const char* key, size_t keyLength, const char*& value, size_t& valueLength ) const
+{
+	if( mapping == NULL )
+	{
+		return false;
+	}
+	
+	unsigned int hashValue = StringHash()( key, keyLength );
+	unsigned int mask = header->slotCount - 1;
+	
+	for( unsigned int index = hashToBucket( hashValue, mask ); 
+	     slots[ index ].keyLength != EMPTY_SLOT;
+	     index = ( index + 1 ) & mask )
+	{
+		const Slot& slot = slots[ index ];
+		
+		if( slot.hashValue == hashValue && slot.keyLength == keyLength
+		    && memcmp( bytes + slot.offset, key, keyLength ) == 0 )
+		{
+			value = bytes + slot.offset + slot.keyLength;
+			valueLength = slot.valueLength;
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+/**
+ * Retrieve.
+ * 
+ * This function searches for a key and copies its value into a string.
+ * 
+ * @param string key passed by const reference.
+ * @param string value passed by reference.
+ * 
+ * @return bool
+ * 
+ */
+bool HashSnapshot::retrieve( const string& key, string& value ) const
+{
+	const char* valueBytes;
+	size_t valueLength;
+	
+	if( !find( key.data(), key.length(), valueBytes, valueLength ) )
+	{
+		return false;
+	}
+	
+	value.assign( valueBytes, valueLength );
+	return true;
+}
+
+/**
+ * Get Count.
+ * 
+ * @return The number of items in the open snapshot.
+ * 
+ */
+int HashSnapshot::getCount() const
+{
+	return ( mapping != NULL ) ? int( header->itemCount ) : 0;
+}
+
+/**
+ * Write.
+ * 
+ * This function builds the slots and bytes of a snapshot in memory and
+ * writes them to a file.
+ * 
+ * @pre The keys and values total less than 4 GB.
+ * @post The file holds a snapshot of the range.  Later items replace
+ * earlier items with the same key.
+ * 
+ * @param const char* fileName.
+ * @param ForwardIterator first.
+ * @param ForwardIterator last.
+ * 
+ * @return bool false if the file could not be written.
+ * 
+ */
+template <typename ForwardIterator>
+bool HashSnapshot::write( const char* fileName, ForwardIterator first, ForwardIterator last )
+{
+	uint32_t slotCount = roundUpToPowerOfTwo( 2 * int( distance( first, last ) ) + 2 );
+	uint32_t itemCount = 0;
+	Slot empty = { 0, 0, EMPTY_SLOT, 0 };
+	vector<Slot> newSlots( slotCount, empty );
+	string newBytes;
+	
+	for( ; first != last; ++first )
+	{
+		const string& key = ( *first ).first;
+		const string& value = ( *first ).second;
+		unsigned int hashValue = StringHash()( key );
+		unsigned int index = hashToBucket( hashValue, slotCount - 1 );
+		
+		while( newSlots[ index ].keyLength != EMPTY_SLOT
+		       && !( newSlots[ index ].hashValue == hashValue
+		             && newBytes.compare( newSlots[ index ].offset, newSlots[ index ].keyLength, key ) == 0 ) )
+		{
+			index = ( index + 1 ) & ( slotCount - 1 );
+		}
+		
+		if( newSlots[ index ].keyLength == EMPTY_SLOT )
+		{
+			itemCount++;
+		}
+		
+		newSlots[ index ].hashValue = hashValue;
+		newSlots[ index ].offset = newBytes.length();
+		newSlots[ index ].keyLength = key.length();
+		newSlots[ index ].valueLength = value.length();
+		newBytes += key;
+		newBytes += value;
+	}
+	
+	return writeFile( fileName, newSlots, newBytes, itemCount );
+}
+
+/**
+ * Write File.
+ * 
+ * This function writes the header, slots and bytes of a snapshot.
+ * 
+ * @return bool false if the file could not be written.
+ * 
+ */
+bool HashSnapshot::writeFile( const char* fileName, const vector<Slot>& newSlots, const string& newBytes, uint32_t itemCount )
+{
+	Header newHeader;
+	ofstream file( fileName, ios::binary | ios::trunc );
+	
+	memcpy( newHeader.magic, MAGIC, sizeof( MAGIC ) );
+	newHeader.slotCount = newSlots.size();
+	newHeader.itemCount = itemCount;
+	newHeader.byteCount = newBytes.length();
+	
+	file.write( reinterpret_cast<const char*>( &newHeader ), sizeof( newHeader ) );
+	file.write( reinterpret_cast<const char*>( &newSlots[ 0 ] ), newSlots.size() * sizeof( Slot ) );
+	file.write( newBytes.data(), newBytes.length() );
+	
+	return file.good();
+}
@@ -0,0 +1,80 @@
+// HashSnapshot.h
+
+#ifndef HASHSNAPSHOT_H
+#define HASHSNAPSHOT_H
+
+#include <stdexcept>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <stdint.h>
+
+using namespace std;
+
+#include "HashFunctions.h"
+
+// Read-only hash table of string keys and string values kept in a binary
+// file.  The file is memory mapped and searched where it lies, so opening
+// a snapshot costs one pass to check the slots and no parsing or inserts
+// however large it is.
+//
+// File layout, in host byte order:
+//   Header   magic, slot count (a power of two), item count, byte count
+//   Slot[]   hash value, offset, key length and value length of each item;
+//            unused slots have a key length of EMPTY_SLOT
+//   bytes    the key of each item immediately followed by its value
+// Items are placed by linear probing from hashToBucket(StringHash(key)),
+// and no more than half of the slots are used.
+class HashSnapshot {
+  public:
+    HashSnapshot();
+    ~HashSnapshot();
+
+    bool open(const char* fileName);
+    void close();
+    bool isOpen() const;
+
+    bool find(const char* key, size_t keyLength,
+              const char*& value, size_t& valueLength) const;
+    bool retrieve(const string& key, string& value) const;
+    int getCount() const;
+
+    // Writes the (key, value) pairs in [first, last) as a snapshot file.
+    // The items need string members first and second, like pair or map.
+    template <typename ForwardIterator>
+    static bool write(const char* fileName, ForwardIterator first,
+                      ForwardIterator last);
+
+  private:
+    HashSnapshot(const HashSnapshot& other);
+    HashSnapshot& operator=(const HashSnapshot& other);
+
+    struct Header {
+	char magic[8];
+	uint32_t slotCount;
+	uint32_t itemCount;
+	uint64_t byteCount;
+    };
+
+    struct Slot {
+	uint32_t hashValue;
+	uint32_t offset;
+	uint32_t keyLength;
+	uint32_t valueLength;
+    };
+
+    static const uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+    static const char MAGIC[8];
+
+    static bool writeFile(const char* fileName, const vector<Slot>& slots,
+                          const string& bytes, uint32_t itemCount);
+
+    void* mapping;
+    size_t mappingLength;
+    const Header* header;
+    const Slot* slots;
+    const char* bytes;
+};
+
+#endif	// ifndef HASHSNAPSHOT_H
@@ -9,8 +9,9 @@
 /**
  * Constructor.
  * 
- * The constructor allocates memory to an array of BSTs.  It only does
- * this if the size is greater than zero.
+ * The constructor allocates the buckets selected by the Buckets policy.
+ * A size that is not greater than zero is treated as a single bucket.
+ * The max load factor starts at the default of the Buckets policy.
  * 
  * @pre A hash table does not exist
  * @post The hash table is created with the size of the tableSize.
@@ -18,15 +19,14 @@
  * @param Int size.
  * 
  */
-template <typename DataType, typename KeyType>
-HashTable<DataType, KeyType>::HashTable( int size )
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+HashTable<DataType, KeyType, Buckets, Hasher>::HashTable( int size )
 {
-	if( size > 0 )
-	{
-		tableSize = size;
-		
-		dataTable = new BSTree<DataType, KeyType>[ tableSize ];
-	}
+	dataTable = new Buckets<DataType, KeyType>( size );
+	oldTable = NULL;
+	rehashIndex = 0;
+	count = 0;
+	maxLoadFactor = Buckets<DataType, KeyType>::defaultMaxLoadFactor();
 }
 
 /**
@@ -41,19 +41,13 @@ HashTable<DataType, KeyType>::HashTable( int size )
  * @param HashTable source passed by const reference.
  * 
  */
-template <typename DataType, typename KeyType>
-HashTable<DataType, KeyType>::HashTable( const HashTable& source )
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+HashTable<DataType, KeyType, Buckets, Hasher>::HashTable( const HashTable& source )
 {
-	tableSize = source.tableSize;
-	dataTable = new BSTree<DataType, KeyType>[ tableSize ];
+	dataTable = NULL;
+	oldTable = NULL;
 	
-	if( !source.isEmpty() )
-	{
-		for( int i = 0; i < tableSize; i++ )
-		{
-			dataTable[ i ] = source[ i ];
-		}
-	}
+	copyTable( source );
 }
 
 /**
@@ -61,9 +55,8 @@ HashTable<DataType, KeyType>::HashTable( const HashTable& source )
  * 
  * The assignment operator assigns one hash table to the existing hash table.
  * It first checks to see if the current object is the same as the source.
- * If it is then it returns the dereferenced this object.  Otherwise it
- * clears the table and creates a new table with the values from the source
- * table.
+ * If it is then it returns the dereferenced this object.  Otherwise the
+ * buckets are replaced with a copy of the source buckets.
  * 
  * @pre A hash table exists
  * @post A hash table is assigned to the source hash table.
@@ -72,8 +65,8 @@ HashTable<DataType, KeyType>::HashTable( const HashTable& source )
  * @return Dereferenced this
  * 
  */
-template <typename DataType, typename KeyType>
-HashTable<DataType, KeyType>& HashTable<DataType, KeyType>::operator=( const HashTable& source )
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+HashTable<DataType, KeyType, Buckets, Hasher>& HashTable<DataType, KeyType, Buckets, Hasher>::operator=( const HashTable& source )
 {
 	if( this == &source )
 	{
@@ -81,19 +74,7 @@ HashTable<DataType, KeyType>& HashTable<DataType, KeyType>::operator=( const Has
 	}
 	else
 	{
-		clear();
-		delete[]dataTable;
-		
-		tableSize = source.tableSize;
-		dataTable = new BSTree<DataType, KeyType>[ tableSize ];
-		
-		if( !source.isEmpty() )
-		{
-			for( int i = 0; i < tableSize; i++ )
-			{
-				dataTable[ i ] = source[ i ];
-			}
-		}
+		copyTable( source );
 	}
 	
 	return *this;
@@ -108,39 +89,124 @@ HashTable<DataType, KeyType>& HashTable<DataType, KeyType>::operator=( const Has
  * @post A hash table is deallocated.
  * 
  */
-template <typename DataType, typename KeyType>
-HashTable<DataType, KeyType>::~HashTable()
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+HashTable<DataType, KeyType, Buckets, Hasher>::~HashTable()
 {
-	delete[]dataTable;
+	delete dataTable;
+	delete oldTable;
 	dataTable = NULL;
+	oldTable = NULL;
 }
 
 /**
  * Insert.
  * 
  * The insert function inserts a new data item into the hash table.  The
- * hash function of the new data item is used to find the index and then
- * the item is inserted into the BST in the hash table.
+ * item is assigned into the buckets, so DataType needs only a default
+ * constructor and assignment, not a copy constructor.
  * 
  * @pre A hash table does not contain a new item
  * @post A hash table contains a new item
  * @param DataType newDataItem passed by const reference.
  * 
  */
-template <typename DataType, typename KeyType>
-void HashTable<DataType, KeyType>::insert( const DataType& newDataItem )
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::insert( const DataType& newDataItem )
+{
+	insertItem( newDataItem );
+}
+
+/**
+ * Move Insert.
+ * 
+ * The insert function inserts a new data item into the hash table by
+ * moving it into the buckets.
+ * 
+ * @pre A hash table does not contain a new item
+ * @post A hash table contains a new item
+ * @param DataType newDataItem passed by rvalue reference; it is moved into
+ * the table and left in a valid but unspecified state.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::insert( DataType&& newDataItem )
+{
+	insertItem( std::move( newDataItem ) );
+}
+
+/**
+ * Insert Item.
+ * 
+ * This function does the work of both forms of insert.  The
+ * hash value of the new item's key is passed to the buckets, which
+ * store the item in the bucket for that hash value.  New items always go
+ * into the current table.  While the table is rehashing, an older copy of
+ * the key is removed from the old table so that it is not counted twice.
+ * Once the load factor passes the max load factor a larger table is
+ * started, and every insert moves a few items over to it.
+ * 
+ * @pre A hash table does not contain a new item
+ * @post A hash table contains a new item
+ * @param Item newDataItem passed by forwarding reference, so that it is
+ * copied or moved into the buckets as the caller passed it.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+template <typename Item>
+void HashTable<DataType, KeyType, Buckets, Hasher>::insertItem( Item&& newDataItem )
+{
+	unsigned int hashValue = hasher( newDataItem.getKey() );
+	bool replaced = false;
+	
+	if( oldTable != NULL )
+	{
+		replaced = oldTable->remove( hashValue, newDataItem.getKey() );
+	}
+	
+	if( dataTable->insert( hashValue, std::forward<Item>( newDataItem ) ) && !replaced )
+	{
+		count++;
+	}
+	
+	if( oldTable != NULL )
+	{
+		rehashStep();
+	}
+	else if( getLoadFactor() > maxLoadFactor )
+	{
+		startRehash();
+	}
+}
+
+/**
+ * Emplace.
+ * 
+ * This function builds a data item from args and moves it into the table,
+ * so a caller holding the fields of an item does not need to build and
+ * copy one first.
+ * 
+ * @pre DataType has a constructor taking args.  The lab data items are
+ * aggregates, so they need one added before they can be emplaced.
+ * @post A hash table contains the new item
+ * 
+ * @param Args args passed by forwarding reference.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+template <typename... Args>
+void HashTable<DataType, KeyType, Buckets, Hasher>::emplace( Args&&... args )
 {
-	dataTable[ newDataItem.hash( newDataItem.getKey() ) % tableSize ].insert( newDataItem );
+	insert( DataType( std::forward<Args>( args )... ) );
 }
 
 /**
  * Remove.
  * 
  * The remove function removes an element from the hash table if it exisits
- * within the hash table.  The hash funciton of a temp item is used in order
- * to find the correct index and then the remove funciton is used by the
- * BST with the delete key.  If the item has been deleted from the BST 
- * in the hash table then a true is returned.  False otherwise.
+ * within the hash table.  The hasher is used in order
+ * to find the correct bucket and then the remove funciton of the buckets
+ * is used with the delete key.  If the item has been deleted from the
+ * hash table then a true is returned.  False otherwise.
  * 
  * @pre A hash table may or may not contain an element
  * @post If the element is contained within the hash table then it is removed
@@ -150,20 +216,35 @@ void HashTable<DataType, KeyType>::insert( const DataType& newDataItem )
  * @return bool 
  * 
  */
-template <typename DataType, typename KeyType>
-bool HashTable<DataType, KeyType>::remove( const KeyType& deleteKey )
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+bool HashTable<DataType, KeyType, Buckets, Hasher>::remove( const KeyType& deleteKey )
 {
-	DataType temp;
+	unsigned int hashValue = hasher( deleteKey );
+	bool removed = dataTable->remove( hashValue, deleteKey );
 	
-	return ( dataTable[ temp.hash( deleteKey ) % tableSize ].remove( deleteKey ) );
+	if( !removed && oldTable != NULL )
+	{
+		removed = oldTable->remove( hashValue, deleteKey );
+	}
+	
+	if( removed )
+	{
+		count--;
+	}
+	
+	if( oldTable != NULL )
+	{
+		rehashStep();
+	}
+	
+	return removed;
 }
 
 /**
  * Retrieve
  * 
  * This funciton retrieves an element from the hash table if it is contained
- * within the hash table.  It uses the return items hash funciton to find
- * the index and then uses the retrieve function of the BST in the hash table.
+ * within the hash table.  It uses find and copies out the item it finds.
  * It returns if the object and if it was retrieved or not as a bool.
  * 
  * @pre An element may or may not be within the hash table.
@@ -174,35 +255,239 @@ bool HashTable<DataType, KeyType>::remove( const KeyType& deleteKey )
  * @return bool
  * 
  */
-template <typename DataType, typename KeyType>
-bool HashTable<DataType, KeyType>::retrieve( const KeyType& searchKey, DataType& returnItem ) const
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+bool HashTable<DataType, KeyType, Buckets, Hasher>::retrieve( const KeyType& searchKey, DataType& returnItem ) const
+{
+	const DataType* found = find( searchKey );
+	
+	if( found == NULL )
+	{
+		return false;
+	}
+	
+	returnItem = *found;
+	return true;
+}
+
+/**
+ * Find
+ * 
+ * This function looks up searchKey without copying anything.  The key may
+ * be any type that the hasher accepts and that compares with KeyType, so
+ * with StringHash a const char* or string_view is searched for without
+ * building a string.  It uses the hasher to find the bucket and then the
+ * find function of the buckets.  While the table is rehashing, keys not
+ * yet moved are found in the old table.
+ * 
+ * @pre none
+ * @post none
+ * 
+ * @param LookupKey searchKey passed by const reference.
+ * 
+ * @return A pointer to the stored item, or NULL if the key is not stored.
+ * The pointer is only good until the next insert, remove or clear.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+template <typename LookupKey>
+const DataType* HashTable<DataType, KeyType, Buckets, Hasher>::find( const LookupKey& searchKey ) const
 {
-	return ( dataTable[ returnItem.hash( searchKey ) % tableSize ].retrieve( searchKey, returnItem ) );
+	unsigned int hashValue = hasher( searchKey );
+	const DataType* found = dataTable->find( hashValue, searchKey );
+	
+	if( found == NULL && oldTable != NULL )
+	{
+		found = oldTable->find( hashValue, searchKey );
+	}
+	
+	return found;
+}
+
+/**
+ * Retrieve Many
+ * 
+ * This function looks up every key in keys.  A loop of finds waits for
+ * each key's cache misses before it starts on the next key; this function
+ * has the memory for many keys loading at once.
+ * 
+ * @pre none
+ * @post results has one entry per key: a pointer to the stored item, or
+ * NULL if the key is not stored.  The pointers are only good until the
+ * next insert, remove or clear.
+ * 
+ * @param vector<LookupKey> keys passed by const reference.
+ * @param vector<const DataType*> results passed by reference.
+ * 
+ * @return The number of keys found.
+ * 
+ * @note ALGORITHM: The keys are taken PREFETCH_BATCH at a time.  Every key
+ * of a batch is hashed and its bucket prefetched, then the batch is
+ * searched in the same order.  By the time the search reaches a key its
+ * bucket has usually arrived.  Batches are kept small so that the lines
+ * prefetched are still in the cache when they are used.  While the table
+ * is rehashing, keys that miss the current table are searched for in the
+ * old table without prefetching.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+template <typename LookupKey>
+int HashTable<DataType, KeyType, Buckets, Hasher>::retrieveMany( const vector<LookupKey>& keys, vector<const DataType*>& results ) const
+{
+	unsigned int hashValues[ PREFETCH_BATCH ];
+	int found = 0;
+	
+	results.resize( keys.size() );
+	
+	for( size_t first = 0; first < keys.size(); first += PREFETCH_BATCH )
+	{
+		int batchSize = min( size_t( PREFETCH_BATCH ), keys.size() - first );
+		
+		for( int i = 0; i < batchSize; i++ )
+		{
+			hashValues[ i ] = hasher( keys[ first + i ] );
+			dataTable->prefetch( hashValues[ i ] );
+		}
+		
+		for( int i = 0; i < batchSize; i++ )
+		{
+			const DataType* item = dataTable->find( hashValues[ i ], keys[ first + i ] );
+			
+			if( item == NULL && oldTable != NULL )
+			{
+				item = oldTable->find( hashValues[ i ], keys[ first + i ] );
+			}
+			
+			if( item != NULL )
+			{
+				found++;
+			}
+			
+			results[ first + i ] = item;
+		}
+	}
+	
+	return found;
 }
 
 /**
  * Clear.
  * 
- * This funciton clears the current hash table.
+ * This funciton clears the current hash table.  The buckets only visit
+ * the buckets they have in use, so clearing a large, sparse table costs
+ * about as much as the items in it.  A rehash in progress is abandoned.
  * 
  * @pre A hash table contains values.
  * @post The hash table is cleared.
  * 
  */
-template <typename DataType, typename KeyType>
-void HashTable<DataType, KeyType>::clear()
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::clear()
+{
+	dataTable->clear();
+	
+	delete oldTable;
+	oldTable = NULL;
+	rehashIndex = 0;
+	count = 0;
+}
+
+/**
+ * Erase If.
+ * 
+ * This function removes every item for which pred returns true.  Each
+ * bucket policy sweeps its own buckets once, and both tables are swept
+ * while the table is rehashing.
+ * 
+ * @pre pred takes a const DataType& and returns bool, without changing
+ * the table.
+ * @post No item left in the table satisfies pred.
+ * 
+ * @param Predicate pred.
+ * 
+ * @return The number of items removed.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+template <typename Predicate>
+int HashTable<DataType, KeyType, Buckets, Hasher>::eraseIf( Predicate pred )
+{
+	int removed = dataTable->eraseIf( pred );
+	
+	if( oldTable != NULL )
+	{
+		removed += oldTable->eraseIf( pred );
+	}
+	
+	count -= removed;
+	return removed;
+}
+
+/**
+ * Begin.
+ * 
+ * @return An iterator at the first item, or end() if the table is empty.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+typename HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator HashTable<DataType, KeyType, Buckets, Hasher>::begin() const
+{
+	return const_iterator( this );
+}
+
+/**
+ * End.
+ * 
+ * @return The iterator past the last item.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+typename HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator HashTable<DataType, KeyType, Buckets, Hasher>::end() const
+{
+	return const_iterator();
+}
+
+/**
+ * Bulk Load.
+ * 
+ * This function inserts every item in the range [first, last).  The
+ * table is first grown, all at once, to the size it would reach through
+ * one-at-a-time inserts, and any rehash in progress is finished.  The
+ * items then go straight into their buckets without any load factor
+ * checks or rehash steps.
+ * 
+ * @pre The iterators can be walked more than once.
+ * @post The hash table contains every item in the range.  Later items
+ * replace earlier items with the same key.
+ * 
+ * @param ForwardIterator first.
+ * @param ForwardIterator last.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+template <typename ForwardIterator>
+void HashTable<DataType, KeyType, Buckets, Hasher>::bulkLoad( ForwardIterator first, ForwardIterator last )
 {
-	for( int i = 0; i < tableSize; i++ )
+	int needed = int( ( count + distance( first, last ) ) / maxLoadFactor ) + 1;
+	
+	if( oldTable != NULL || needed > dataTable->getBucketCount() )
 	{
-		dataTable[ i ].clear();
+		resize( ( needed > dataTable->getBucketCount() ) ? needed : dataTable->getBucketCount() );
+	}
+	
+	for( ; first != last; ++first )
+	{
+		if( dataTable->insert( hasher( ( *first ).getKey() ), *first ) )
+		{
+			count++;
+		}
 	}
 }
 
 /**
  * isEmpty
  * 
- * This funciton checks the hash table to see if it is empty.  It checks
- * every BST in the hash table to see if they are all empty.
+ * This funciton checks the hash table to see if it is empty by checking
+ * the count of items.
  * 
  * @pre A hash table exists
  * @post A hash table is checked to see if it contains any values.
@@ -210,19 +495,604 @@ void HashTable<DataType, KeyType>::clear()
  * @return bool.
  * 
  */
-template <typename DataType, typename KeyType>
-bool HashTable<DataType, KeyType>::isEmpty() const
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+bool HashTable<DataType, KeyType, Buckets, Hasher>::isEmpty() const
+{
+	return ( count == 0 );
+}
+
+/**
+ * Standard Deviation.
+ * 
+ * This function measures how evenly the hash function spreads the items
+ * over the buckets.  A perfect hash function gives every bucket the same
+ * number of items and a standard deviation of zero.
+ * 
+ * @return The sample standard deviation of the number of items in each
+ * bucket.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+double HashTable<DataType, KeyType, Buckets, Hasher>::standardDeviation() const
 {
-	if( dataTable != NULL )
+	vector<int> lengths;
+	
+	getBucketLengths( lengths );
+	
+	return lengthDeviation( lengths );
+}
+
+/**
+ * Get Stats.
+ * 
+ * This function collects the bucket distribution of the table: the bucket
+ * length histogram, the longest bucket, the tree height of every bucket
+ * (chained buckets only), the probes needed to find every stored key and
+ * the memory used per item.  No misses are measured.
+ * 
+ * @return HashTableStats
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+HashTableStats HashTable<DataType, KeyType, Buckets, Hasher>::getStats() const
+{
+	KeyType* none = NULL;
+	
+	return getStats( none, none );
+}
+
+/**
+ * Get Stats with misses.
+ * 
+ * This function collects the same statistics as getStats() and also
+ * measures the probes of a retrieve for each key in [missFirst, missLast).
+ * Those keys are expected not to be stored, but are measured either way.
+ * 
+ * @param ForwardIterator missFirst.
+ * @param ForwardIterator missLast.
+ * 
+ * @return HashTableStats
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+template <typename ForwardIterator>
+HashTableStats HashTable<DataType, KeyType, Buckets, Hasher>::getStats( ForwardIterator missFirst, ForwardIterator missLast ) const
+{
+	HashTableStats stats;
+	vector<int> lengths;
+	vector<int> probes;
+	
+	getBucketLengths( lengths );
+	
+	stats.itemCount = count;
+	stats.bucketCount = lengths.size();
+	stats.usedBuckets = 0;
+	stats.maxChainLength = 0;
+	stats.standardDeviation = lengthDeviation( lengths );
+	
+	for( unsigned int i = 0; i < lengths.size(); i++ )
 	{
-		for( int i = 0; i < tableSize; i++ )
+		if( lengths[ i ] > stats.maxChainLength )
 		{
-			if( !dataTable[ i ].isEmpty() )
-			{
-				return false;
-			}
+			stats.maxChainLength = lengths[ i ];
+			stats.lengthHistogram.resize( lengths[ i ] + 1, 0 );
+		}
+		
+		if( lengths[ i ] > 0 )
+		{
+			stats.usedBuckets++;
 		}
 	}
 	
-	return true;
+	stats.lengthHistogram.resize( stats.maxChainLength + 1, 0 );
+	
+	for( unsigned int i = 0; i < lengths.size(); i++ )
+	{
+		stats.lengthHistogram[ lengths[ i ] ]++;
+	}
+	
+	dataTable->getBucketHeights( stats.bucketHeights );
+	dataTable->getHitProbes( probes );
+	stats.memoryBytes = sizeof( *this ) + dataTable->getMemoryBytes();
+	
+	if( oldTable != NULL )
+	{
+		oldTable->getBucketHeights( stats.bucketHeights );
+		oldTable->getHitProbes( probes );
+		stats.memoryBytes += oldTable->getMemoryBytes();
+	}
+	
+	stats.hits = summarizeProbes( probes );
+	stats.bytesPerItem = ( count > 0 ) ? double( stats.memoryBytes ) / count : 0;
+	
+	probes.clear();
+	
+	for( ; missFirst != missLast; ++missFirst )
+	{
+		unsigned int hashValue = hasher( *missFirst );
+		int missProbes = dataTable->probeCount( hashValue, *missFirst );
+		
+		if( oldTable != NULL )
+		{
+			missProbes += oldTable->probeCount( hashValue, *missFirst );
+		}
+		
+		probes.push_back( missProbes );
+	}
+	
+	stats.misses = summarizeProbes( probes );
+	
+	return stats;
+}
+
+/**
+ * Get Count.
+ * 
+ * @return The number of items in the hash table.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+int HashTable<DataType, KeyType, Buckets, Hasher>::getCount() const
+{
+	return count;
+}
+
+/**
+ * Get Load Factor.
+ * 
+ * @return The number of items per bucket of the current table.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+double HashTable<DataType, KeyType, Buckets, Hasher>::getLoadFactor() const
+{
+	return ( double( count ) / dataTable->getBucketCount() );
+}
+
+/**
+ * Get Max Load Factor.
+ * 
+ * @return The load factor above which the table grows.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+double HashTable<DataType, KeyType, Buckets, Hasher>::getMaxLoadFactor() const
+{
+	return maxLoadFactor;
+}
+
+/**
+ * Set Max Load Factor.
+ * 
+ * This function sets the load factor above which the table grows.  The
+ * next insert starts growing the table if it is already above it.
+ * Robin Hood buckets also grow on their own, all at once, if they become
+ * seven eighths full, so a max load factor above that only costs pauses.
+ * 
+ * @pre none
+ * @post The max load factor is set.
+ * 
+ * @param double newMaxLoadFactor.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::setMaxLoadFactor( double newMaxLoadFactor )
+{
+	if( newMaxLoadFactor <= 0 )
+	{
+		throw logic_error( "setMaxLoadFactor() with a factor that is not positive" );
+	}
+	
+	maxLoadFactor = newMaxLoadFactor;
+}
+
+/**
+ * Is Rehashing.
+ * 
+ * @return bool true while items are still being moved to a larger table.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+bool HashTable<DataType, KeyType, Buckets, Hasher>::isRehashing() const
+{
+	return ( oldTable != NULL );
+}
+
+/**
+ * Copy Table.
+ * 
+ * This function replaces the contents of the hash table with a copy of
+ * the source hash table, including a rehash that is in progress.
+ * 
+ * @pre The source is not this hash table.
+ * @post The hash table is a copy of the source.
+ * 
+ * @param HashTable source passed by const reference.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::copyTable( const HashTable& source )
+{
+	delete dataTable;
+	delete oldTable;
+	
+	dataTable = new Buckets<DataType, KeyType>( *source.dataTable );
+	oldTable = NULL;
+	
+	if( source.oldTable != NULL )
+	{
+		oldTable = new Buckets<DataType, KeyType>( *source.oldTable );
+	}
+	
+	rehashIndex = source.rehashIndex;
+	count = source.count;
+	maxLoadFactor = source.maxLoadFactor;
+	hasher = source.hasher;
+}
+
+/**
+ * Start Rehash.
+ * 
+ * This function makes the current table the old table and allocates a
+ * new current table with twice as many buckets.  Nothing is moved yet.
+ * 
+ * @pre The table is not rehashing.
+ * @post The table is rehashing into a table twice the size.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::startRehash()
+{
+	oldTable = dataTable;
+	dataTable = new Buckets<DataType, KeyType>( oldTable->getBucketCount() * 2 );
+	rehashIndex = 0;
+}
+
+/**
+ * Rehash Step.
+ * 
+ * This function moves up to REHASH_STEPS items from the old table into the
+ * current table, so that no single operation pays for the whole rehash.
+ * 
+ * @pre The table is rehashing.
+ * @post A few more items are in the current table.  Once the old table is
+ * empty it is deallocated and the rehash is over.
+ * 
+ * @note ALGORITHM: The old buckets are visited in order starting from
+ * rehashIndex.  Items are taken out of the bucket at rehashIndex one at a
+ * time, rehashed with the hasher and inserted into the
+ * current table.  The index only moves on once the bucket is empty.  Empty
+ * buckets are cheap to skip but are still limited to ten per step so a
+ * sparse old table cannot turn one step into a long scan.  Because the
+ * current table is twice as large and every insert moves several items,
+ * the rehash always finishes before the current table is full enough to
+ * need growing itself.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::rehashStep()
+{
+	DataType item;
+	int moved = 0;
+	int skipped = 0;
+	
+	while( moved < REHASH_STEPS && skipped < REHASH_STEPS * 10 )
+	{
+		if( oldTable->takeItem( rehashIndex, item ) )
+		{
+			dataTable->insert( hasher( item.getKey() ), std::move( item ) );
+			moved++;
+		}
+		else if( ++rehashIndex == oldTable->getBucketCount() )
+		{
+			delete oldTable;
+			oldTable = NULL;
+			rehashIndex = 0;
+			return;
+		}
+		else
+		{
+			skipped++;
+		}
+	}
+}
+
+/**
+ * Resize.
+ * 
+ * This function moves every item, including any still in the old table,
+ * into new buckets of at least newBucketCount.  Unlike the incremental
+ * rehash it does all of the work at once.
+ * 
+ * @pre none
+ * @post The table is not rehashing and has the new bucket count.
+ * 
+ * @param int newBucketCount.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::resize( int newBucketCount )
+{
+	Buckets<DataType, KeyType>* newTable = new Buckets<DataType, KeyType>( newBucketCount );
+	
+	moveItems( dataTable, newTable );
+	delete dataTable;
+	dataTable = newTable;
+	
+	if( oldTable != NULL )
+	{
+		moveItems( oldTable, dataTable );
+		delete oldTable;
+		oldTable = NULL;
+		rehashIndex = 0;
+	}
+}
+
+/**
+ * Move Items.
+ * 
+ * This function empties the source buckets into the dest buckets.
+ * 
+ * @pre The dest buckets do not hold any key of the source buckets.
+ * @post The source buckets are empty.
+ * 
+ * @param Buckets source.
+ * @param Buckets dest.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::moveItems( Buckets<DataType, KeyType>* source, Buckets<DataType, KeyType>* dest )
+{
+	DataType item;
+	
+	for( int i = 0; i < source->getBucketCount(); i++ )
+	{
+		while( source->takeItem( i, item ) )
+		{
+			dest->insert( hasher( item.getKey() ), std::move( item ) );
+		}
+	}
+}
+
+/**
+ * Get Bucket Lengths.
+ * 
+ * This function collects the number of items in every bucket of the
+ * current table and, while rehashing, of the old table.
+ * 
+ * @param vector<int> lengths passed by reference.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::getBucketLengths( vector<int>& lengths ) const
+{
+	dataTable->getBucketLengths( lengths );
+	
+	if( oldTable != NULL )
+	{
+		oldTable->getBucketLengths( lengths );
+	}
+}
+
+/**
+ * Length Deviation.
+ * 
+ * @param vector<int> lengths passed by const reference.
+ * 
+ * @return The sample standard deviation of the lengths.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+double HashTable<DataType, KeyType, Buckets, Hasher>::lengthDeviation( const vector<int>& lengths )
+{
+	double mean = 0;
+	double sum = 0;
+	
+	if( lengths.size() < 2 )
+	{
+		return 0;
+	}
+	
+	for( unsigned int i = 0; i < lengths.size(); i++ )
+	{
+		mean += lengths[ i ];
+	}
+	
+	mean /= lengths.size();
+	
+	for( unsigned int i = 0; i < lengths.size(); i++ )
+	{
+		sum += ( lengths[ i ] - mean ) * ( lengths[ i ] - mean );
+	}
+	
+	return sqrt( sum / ( lengths.size() - 1 ) );
+}
+
+/**
+ * Summarize Probes.
+ * 
+ * This function sorts a list of probe counts and summarizes it.
+ * 
+ * @param vector<int> probes passed by reference; it is sorted.
+ * 
+ * @return ProbeStats with the mean, the 50th, 90th and 99th percentiles
+ * and the largest count, or all zeros if the list is empty.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+ProbeStats HashTable<DataType, KeyType, Buckets, Hasher>::summarizeProbes( vector<int>& probes )
+{
+	ProbeStats summary = { 0, 0, 0, 0, 0, 0 };
+	double total = 0;
+	int last = int( probes.size() ) - 1;
+	
+	if( probes.empty() )
+	{
+		return summary;
+	}
+	
+	sort( probes.begin(), probes.end() );
+	
+	for( unsigned int i = 0; i < probes.size(); i++ )
+	{
+		total += probes[ i ];
+	}
+	
+	summary.lookups = probes.size();
+	summary.mean = total / probes.size();
+	summary.p50 = probes[ last * 50 / 100 ];
+	summary.p90 = probes[ last * 90 / 100 ];
+	summary.p99 = probes[ last * 99 / 100 ];
+	summary.max = probes[ last ];
+	
+	return summary;
+}
+
+/**
+ * Iterator Constructor.
+ * 
+ * The default iterator is the end iterator of every table.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::const_iterator()
+{
+	table = NULL;
+	buckets = NULL;
+	item = NULL;
+}
+
+/**
+ * Iterator Constructor.
+ * 
+ * This constructor starts an iteration at the first item of the current
+ * table, or of the old table if the current table is empty.
+ * 
+ * @param HashTable source, the table to iterate over.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::const_iterator( const HashTable* source )
+{
+	table = source;
+	buckets = source->dataTable;
+	item = buckets->first( cursor );
+	
+	if( item == NULL )
+	{
+		nextTable();
+	}
+}
+
+/**
+ * Iterator Dereference.
+ * 
+ * @pre The iterator is not at the end.
+ * 
+ * @return The current item.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+typename HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::reference HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::operator*() const
+{
+	return *item;
+}
+
+/**
+ * Iterator Member Access.
+ * 
+ * @pre The iterator is not at the end.
+ * 
+ * @return A pointer to the current item.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+typename HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::pointer HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::operator->() const
+{
+	return item;
+}
+
+/**
+ * Iterator Pre-increment.
+ * 
+ * This function moves on to the next item.  After the last item of the
+ * current table come the items still in the old table.
+ * 
+ * @pre The iterator is not at the end.
+ * @post The iterator is at the next item or at the end.
+ * 
+ * @return Dereferenced this
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+typename HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator& HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::operator++()
+{
+	item = buckets->next( cursor );
+	
+	if( item == NULL )
+	{
+		nextTable();
+	}
+	
+	return *this;
+}
+
+/**
+ * Iterator Post-increment.
+ * 
+ * @return A copy of the iterator from before it moved on.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+typename HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::operator++( int )
+{
+	const_iterator previous = *this;
+	
+	++*this;
+	return previous;
+}
+
+/**
+ * Iterator Equality.
+ * 
+ * @return bool true if both iterators are at the same item, or both are
+ * at the end.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+bool HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::operator==( const const_iterator& other ) const
+{
+	return ( item == other.item );
+}
+
+/**
+ * Iterator Inequality.
+ * 
+ * @return bool true if the iterators are at different items.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+bool HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::operator!=( const const_iterator& other ) const
+{
+	return ( item != other.item );
+}
+
+/**
+ * Iterator Next Table.
+ * 
+ * This function moves an iteration that has run off the end of the
+ * current table onto the old table, if the table is rehashing.
+ * 
+ * @pre item is NULL.
+ * @post item is the first item of the old table, or NULL.
+ * 
+ */
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::const_iterator::nextTable()
+{
+	if( buckets == table->dataTable && table->oldTable != NULL )
+	{
+		buckets = table->oldTable;
+		item = buckets->first( cursor );
+	}
 }
@@ -6,14 +6,54 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <iterator>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <utility>
 
 using namespace std;
 
-#include "BSTree.cpp"
+#include "HashFunctions.h"
+#include "ChainedBuckets.cpp"
+#include "RobinHoodBuckets.cpp"
 
-template <typename DataType, typename KeyType>
+// Probe lengths over a set of lookups.  A probe is one tree node visited
+// for chained buckets, or one slot looked at for Robin Hood buckets.
+struct ProbeStats {
+    int lookups;
+    double mean;
+    int p50, p90, p99, max;
+};
+
+// Bucket distribution and cost of a HashTable, as returned by getStats().
+// While the table is rehashing both of its tables are included.
+struct HashTableStats {
+    int itemCount;
+    int bucketCount;
+    int usedBuckets;
+    int maxChainLength;
+    double standardDeviation;		// Of the bucket lengths
+    vector<int> lengthHistogram;	// [k] = number of buckets holding k items
+    vector<int> bucketHeights;		// BSTree height per bucket; empty for
+					//   slot-based buckets
+    ProbeStats hits;			// Over every stored key
+    ProbeStats misses;			// Over the miss keys given to getStats
+    size_t memoryBytes;			// Not counting memory the items own
+    double bytesPerItem;
+};
+
+// Buckets selects how the table stores its items: ChainedBuckets keeps a
+// BSTree per bucket, RobinHoodBuckets keeps every item in one flat array.
+// Hasher maps keys to hash values; the default calls DataType::hash(),
+// StringHash and IntegerHash in HashFunctions.h are much stronger.
+template <typename DataType, typename KeyType,
+          template <typename, typename> class Buckets = ChainedBuckets,
+          typename Hasher = DataTypeHash<DataType, KeyType> >
 class HashTable {
   public:
+    class const_iterator;
+
     HashTable(int initTableSize);
     HashTable(const HashTable& other);
     HashTable& operator=(const HashTable& other);
@@ -21,21 +61,111 @@ class HashTable {
     ~HashTable();
 
     void insert(const DataType& newDataItem);
+    void insert(DataType&& newDataItem);
+    template <typename... Args>
+    void emplace(Args&&... args);
     bool remove(const KeyType& deleteKey);
     bool retrieve(const KeyType& searchKey, DataType& returnItem) const;
+
+    // Lookup without copying the item; the key may be any type the hasher
+    // takes that compares with KeyType, e.g. a const char* for string keys
+    template <typename LookupKey>
+    const DataType* find(const LookupKey& searchKey) const;
+
+    // Looks up a batch of keys with their cache misses overlapped;
+    // results[i] is what find(keys[i]) would return
+    template <typename LookupKey>
+    int retrieveMany(const vector<LookupKey>& keys,
+                     vector<const DataType*>& results) const;
     void clear();
 
+    // Removes every item for which pred(item) is true, in one pass
+    template <typename Predicate>
+    int eraseIf(Predicate pred);
+
+    // Iteration over the items in no particular order.  Any insert,
+    // remove, clear or eraseIf invalidates the iterators.
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    // Inserts a range of items after sizing the table for all of them
+    template <typename ForwardIterator>
+    void bulkLoad(ForwardIterator first, ForwardIterator last);
+
     bool isEmpty() const;
 
     void showStructure() const;
 
     double standardDeviation() const;
 
+    // Hash quality statistics; the second form also measures misses by
+    // searching for every key in [missFirst, missLast)
+    HashTableStats getStats() const;
+    template <typename ForwardIterator>
+    HashTableStats getStats(ForwardIterator missFirst, ForwardIterator missLast) const;
+
+    // Growth control
+    int getCount() const;
+    double getLoadFactor() const;
+    double getMaxLoadFactor() const;
+    void setMaxLoadFactor(double newMaxLoadFactor);
+    bool isRehashing() const;
+
   private:
+    // Items moved from oldTable to dataTable by each insert or remove
+    static const int REHASH_STEPS = 4;
+
+    // Keys hashed and prefetched together by retrieveMany
+    static const int PREFETCH_BATCH = 16;
+
+    template <typename Item>
+    void insertItem(Item&& newDataItem);
     void copyTable(const HashTable& source);
+    void startRehash();
+    void rehashStep();
+    void resize(int newBucketCount);
+    void getBucketLengths(vector<int>& lengths) const;
+    static double lengthDeviation(const vector<int>& lengths);
+    static ProbeStats summarizeProbes(vector<int>& probes);
+    void moveItems(Buckets<DataType, KeyType>* source,
+                   Buckets<DataType, KeyType>* dest);
+
+    Buckets<DataType, KeyType>* dataTable;
+    Buckets<DataType, KeyType>* oldTable;	// NULL unless rehashing
+    int rehashIndex;			// Next oldTable bucket to move
+    int count;
+    double maxLoadFactor;
+    Hasher hasher;
+
+  public:
+    class const_iterator {
+      public:
+	typedef forward_iterator_tag iterator_category;
+	typedef DataType value_type;
+	typedef ptrdiff_t difference_type;
+	typedef const DataType* pointer;
+	typedef const DataType& reference;
+
+	const_iterator();
+
+	reference operator*() const;
+	pointer operator->() const;
+	const_iterator& operator++();
+	const_iterator operator++(int);
+	bool operator==(const const_iterator& other) const;
+	bool operator!=(const const_iterator& other) const;
+
+      private:
+	friend class HashTable;
+
+	const_iterator(const HashTable* source);
+	void nextTable();
 
-    int tableSize;
-    BSTree<DataType, KeyType>* dataTable;
+	const HashTable* table;
+	const Buckets<DataType, KeyType>* buckets;	// dataTable, then oldTable
+	typename Buckets<DataType, KeyType>::Cursor cursor;
+	const DataType* item;			// NULL at the end
+    };
 };
 
 #endif	// ifndef HASHTABLE_H
@@ -0,0 +1,688 @@
+/**
+ * @file RobinHoodBuckets.cpp
+ * @author Amardeep Singh
+ * @brief This program stores the buckets of a hash table in one flat array
+ * using open addressing with Robin Hood linear probing.
+*/
+#include "RobinHoodBuckets.h"
+
+/**
+ * Slot constructor.
+ * 
+ * A new slot is empty.
+ * 
+ */
+template <typename DataType, typename KeyType>
+RobinHoodBuckets<DataType, KeyType>::Slot::Slot()
+{
+	hashValue = 0;
+	distance = EMPTY;
+}
+
+/**
+ * Constructor.
+ * 
+ * The constructor allocates the array of empty slots.  The size is rounded
+ * up to a power of two so that slots are selected and wrapped by masking.
+ * 
+ * @pre The slots do not exist.
+ * @post The slots are created with the size of initBucketCount.
+ * 
+ * @param Int initBucketCount.
+ * 
+ */
+template <typename DataType, typename KeyType>
+RobinHoodBuckets<DataType, KeyType>::RobinHoodBuckets( int initBucketCount )
+{
+	bucketCount = roundUpToPowerOfTwo( initBucketCount );
+	count = 0;
+	slots = new Slot[ bucketCount ];
+	occupied = BucketBitmap( bucketCount );
+}
+
+/**
+ * Copy Constructor.
+ * 
+ * The copy constructor creates a slot array that is a copy of the source
+ * slot array.
+ * 
+ * @pre The slots do not exist.
+ * @post The slots are created with the values from the source slots.
+ * 
+ * @param RobinHoodBuckets source passed by const reference.
+ * 
+ */
+template <typename DataType, typename KeyType>
+RobinHoodBuckets<DataType, KeyType>::RobinHoodBuckets( const RobinHoodBuckets& source )
+{
+	bucketCount = source.bucketCount;
+	count = source.count;
+	slots = new Slot[ bucketCount ];
+	occupied = source.occupied;
+
+	for( int i = 0; i < bucketCount; i++ )
+	{
+		slots[ i ] = source.slots[ i ];
+	}
+}
+
+/**
+ * Overloaded assignment operator.
+ * 
+ * The assignment operator replaces the slots with a copy of the source
+ * slots.  Nothing is done on self assignment.
+ * 
+ * @pre The slots exist.
+ * @post The slots hold a copy of the source slots.
+ * 
+ * @param RobinHoodBuckets source passed by const reference
+ * @return Dereferenced this
+ * 
+ */
+template <typename DataType, typename KeyType>
+RobinHoodBuckets<DataType, KeyType>& RobinHoodBuckets<DataType, KeyType>::operator=( const RobinHoodBuckets& source )
+{
+	if( this != &source )
+	{
+		delete[]slots;
+
+		bucketCount = source.bucketCount;
+		count = source.count;
+		slots = new Slot[ bucketCount ];
+		occupied = source.occupied;
+
+		for( int i = 0; i < bucketCount; i++ )
+		{
+			slots[ i ] = source.slots[ i ];
+		}
+	}
+
+	return *this;
+}
+
+/**
+ * Destructor.
+ * 
+ * The destructor deallocates the slot array.
+ * 
+ * @pre The slots exist.
+ * @post The slots are deallocated.
+ * 
+ */
+template <typename DataType, typename KeyType>
+RobinHoodBuckets<DataType, KeyType>::~RobinHoodBuckets()
+{
+	delete[]slots;
+	slots = NULL;
+}
+
+/**
+ * Insert.
+ * 
+ * The insert function replaces the item with the same key if there is one.
+ * Otherwise the new item is placed in the slot array, which is first grown
+ * if it is seven eighths full.
+ * 
+ * @pre The hash value was computed from the key of newDataItem.
+ * @post The slots contain the new item.
+ * 
+ * @param unsigned int hashValue.
+ * @param Item newDataItem passed by forwarding reference; it is copied
+ * from if it is an lvalue and moved from if it is an rvalue.
+ * 
+ * @return bool true if the key was not stored before.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename Item>
+bool RobinHoodBuckets<DataType, KeyType>::insert( unsigned int hashValue, Item&& newDataItem )
+{
+	int index = findSlot( hashValue, newDataItem.getKey() );
+
+	if( index != EMPTY )
+	{
+		slots[ index ].dataItem = std::forward<Item>( newDataItem );
+		return false;
+	}
+
+	if( ( count + 1 ) * 8 > bucketCount * 7 )
+	{
+		grow();
+	}
+
+	place( hashValue, std::forward<Item>( newDataItem ) );
+	count++;
+
+	return true;
+}
+
+/**
+ * Remove.
+ * 
+ * The remove function removes the item with deleteKey from the slots if
+ * it is stored there.
+ * 
+ * @pre The hash value was computed from deleteKey.
+ * @post If the key was stored then it is removed.
+ * 
+ * @param unsigned int hashValue.
+ * @param KeyType deleteKey passed by const reference.
+ * 
+ * @return bool
+ * 
+ */
+template <typename DataType, typename KeyType>
+bool RobinHoodBuckets<DataType, KeyType>::remove( unsigned int hashValue, const KeyType& deleteKey )
+{
+	int index = findSlot( hashValue, deleteKey );
+
+	if( index == EMPTY )
+	{
+		return false;
+	}
+
+	erase( index );
+
+	return true;
+}
+
+/**
+ * Find.
+ * 
+ * The find function searches the slots for searchKey.  The key may be of
+ * any type that compares with KeyType, such as a const char* for string
+ * keys.
+ * 
+ * @pre The hash value was computed from searchKey.
+ * @post none
+ * 
+ * @param unsigned int hashValue.
+ * @param LookupKey searchKey passed by const reference.
+ * 
+ * @return A pointer to the stored item, or NULL if the key is not stored.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename LookupKey>
+const DataType* RobinHoodBuckets<DataType, KeyType>::find( unsigned int hashValue, const LookupKey& searchKey ) const
+{
+	int index = findSlot( hashValue, searchKey );
+
+	if( index == EMPTY )
+	{
+		return NULL;
+	}
+
+	return &slots[ index ].dataItem;
+}
+
+/**
+ * Prefetch.
+ * 
+ * This function starts loading the home slot of the hash value, so that a
+ * find issued shortly after does not wait for it.
+ * 
+ * @pre none
+ * @post none
+ * 
+ * @param unsigned int hashValue.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void RobinHoodBuckets<DataType, KeyType>::prefetch( unsigned int hashValue ) const
+{
+	prefetchForRead( &slots[ hashToBucket( hashValue, bucketCount - 1 ) ] );
+}
+
+/**
+ * Clear.
+ * 
+ * This function empties every slot.  Only the slots in use are visited,
+ * so clearing a sparse table costs little more than the number of items.
+ * 
+ * @pre The slots contain values.
+ * @post The slots are empty.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void RobinHoodBuckets<DataType, KeyType>::clear()
+{
+	for( int i = occupied.next( 0 ); i != -1; i = occupied.next( i + 1 ) )
+	{
+		slots[ i ] = Slot();
+	}
+
+	occupied.clear();
+	count = 0;
+}
+
+/**
+ * isEmpty
+ * 
+ * @return bool if no slot is in use.
+ * 
+ */
+template <typename DataType, typename KeyType>
+bool RobinHoodBuckets<DataType, KeyType>::isEmpty() const
+{
+	return ( count == 0 );
+}
+
+/**
+ * Get Bucket Count.
+ * 
+ * @return The number of slots.
+ * 
+ */
+template <typename DataType, typename KeyType>
+int RobinHoodBuckets<DataType, KeyType>::getBucketCount() const
+{
+	return bucketCount;
+}
+
+/**
+ * Write Keys.
+ * 
+ * This function writes out the key stored in one slot, if any.  It is used
+ * by showStructure.
+ * 
+ * @param int bucket.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void RobinHoodBuckets<DataType, KeyType>::writeKeys( int bucket ) const
+{
+	if( slots[ bucket ].distance != EMPTY )
+	{
+		cout << slots[ bucket ].dataItem.getKey() << " ";
+	}
+
+	cout << endl;
+}
+
+/**
+ * Take Item.
+ * 
+ * This function removes the item in one slot and moves it out by reference.
+ * It is used to move the items into a larger table.  Because removal
+ * shifts the following items back, the same slot may hold another item
+ * afterwards.
+ * 
+ * @pre none
+ * @post If the slot was in use then the slots hold one item less.
+ * 
+ * @param int bucket.
+ * @param DataType returnItem passed by reference.
+ * 
+ * @return bool false if the slot was empty.
+ * 
+ */
+template <typename DataType, typename KeyType>
+bool RobinHoodBuckets<DataType, KeyType>::takeItem( int bucket, DataType& returnItem )
+{
+	if( slots[ bucket ].distance == EMPTY )
+	{
+		return false;
+	}
+
+	returnItem = std::move( slots[ bucket ].dataItem );
+	erase( bucket );
+
+	return true;
+}
+
+/**
+ * Erase If.
+ * 
+ * This function removes every item for which pred returns true, visiting
+ * only the slots in use.
+ * 
+ * @pre pred takes a const DataType& and returns bool, and gives the same
+ * answer if it is asked about an item twice.
+ * @post No item left in the slots satisfies pred.
+ * 
+ * @param Predicate pred passed by reference.
+ * 
+ * @return The number of items removed.
+ * 
+ * @note ALGORITHM: Erasing a slot shifts the following items back, so the
+ * same slot is tested again before the scan moves on.  An item near the
+ * start of the array whose cluster wraps around the end may be shifted
+ * past the end after it was kept, and is then tested a second time.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename Predicate>
+int RobinHoodBuckets<DataType, KeyType>::eraseIf( Predicate& pred )
+{
+	int removed = 0;
+	int index = occupied.next( 0 );
+	
+	while( index != -1 )
+	{
+		if( pred( const_cast<const DataType&>( slots[ index ].dataItem ) ) )
+		{
+			erase( index );
+			removed++;
+			
+			if( slots[ index ].distance != EMPTY )
+			{
+				continue;
+			}
+		}
+		
+		index = occupied.next( index + 1 );
+	}
+	
+	return removed;
+}
+
+/**
+ * First.
+ * 
+ * This function starts an iteration over the items.
+ * 
+ * @pre none
+ * @post cursor is at the first item.
+ * 
+ * @param Cursor cursor passed by reference.
+ * 
+ * @return A pointer to the first item, or NULL if there are no items.
+ * 
+ */
+template <typename DataType, typename KeyType>
+const DataType* RobinHoodBuckets<DataType, KeyType>::first( Cursor& cursor ) const
+{
+	cursor.slot = occupied.next( 0 );
+	
+	return ( cursor.slot == -1 ) ? NULL : &slots[ cursor.slot ].dataItem;
+}
+
+/**
+ * Next.
+ * 
+ * This function moves an iteration on to the next slot in use.
+ * 
+ * @pre cursor is at an item.
+ * @post cursor is at the next item.
+ * 
+ * @param Cursor cursor passed by reference.
+ * 
+ * @return A pointer to the next item, or NULL if there are no more items.
+ * 
+ */
+template <typename DataType, typename KeyType>
+const DataType* RobinHoodBuckets<DataType, KeyType>::next( Cursor& cursor ) const
+{
+	cursor.slot = occupied.next( cursor.slot + 1 );
+	
+	return ( cursor.slot == -1 ) ? NULL : &slots[ cursor.slot ].dataItem;
+}
+
+/**
+ * Default Max Load Factor.
+ * 
+ * @return The fraction of slots that a HashTable using Robin Hood buckets
+ * lets itself fill before it grows.  It is kept below the seven eighths
+ * at which insert grows the slots all at once.
+ * 
+ */
+template <typename DataType, typename KeyType>
+double RobinHoodBuckets<DataType, KeyType>::defaultMaxLoadFactor()
+{
+	return 0.8;
+}
+
+/**
+ * Get Bucket Lengths.
+ * 
+ * This function appends, for every slot, the number of items whose home
+ * slot it is.
+ * 
+ * @param vector<int> lengths passed by reference.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void RobinHoodBuckets<DataType, KeyType>::getBucketLengths( vector<int>& lengths ) const
+{
+	size_t first = lengths.size();
+	
+	lengths.resize( first + bucketCount, 0 );
+	
+	for( int i = 0; i < bucketCount; i++ )
+	{
+		if( slots[ i ].distance != EMPTY )
+		{
+			lengths[ first + ( ( i - slots[ i ].distance ) & ( bucketCount - 1 ) ) ]++;
+		}
+	}
+}
+
+/**
+ * Get Bucket Heights.
+ * 
+ * Slots are not trees, so no heights are appended.
+ * 
+ * @param vector<int> heights passed by reference.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void RobinHoodBuckets<DataType, KeyType>::getBucketHeights( vector<int>& ) const
+{
+	// Robin Hood buckets are slots, not trees, so there are no heights.
+}
+
+/**
+ * Get Hit Probes.
+ * 
+ * This function appends, for every stored item, the number of slots a
+ * retrieve of its key looks at.
+ * 
+ * @param vector<int> probes passed by reference.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void RobinHoodBuckets<DataType, KeyType>::getHitProbes( vector<int>& probes ) const
+{
+	for( int i = 0; i < bucketCount; i++ )
+	{
+		if( slots[ i ].distance != EMPTY )
+		{
+			probes.push_back( slots[ i ].distance + 1 );
+		}
+	}
+}
+
+/**
+ * Probe Count.
+ * 
+ * @param unsigned int hashValue.
+ * @param KeyType searchKey passed by const reference.
+ * 
+ * @return The number of slots a retrieve of searchKey looks at, including
+ * the slot that ends a miss.
+ * 
+ */
+template <typename DataType, typename KeyType>
+int RobinHoodBuckets<DataType, KeyType>::probeCount( unsigned int hashValue, const KeyType& searchKey ) const
+{
+	int index = hashToBucket( hashValue, bucketCount - 1 );
+	int distance = 0;
+	
+	while( slots[ index ].distance >= distance )
+	{
+		if( slots[ index ].hashValue == hashValue
+		    && slots[ index ].dataItem.getKey() == searchKey )
+		{
+			break;
+		}
+		
+		index = ( index + 1 ) & ( bucketCount - 1 );
+		distance++;
+	}
+	
+	return distance + 1;
+}
+
+/**
+ * Get Memory Bytes.
+ * 
+ * @return The bytes used by the slot array, not counting memory the items
+ * own themselves.
+ * 
+ */
+template <typename DataType, typename KeyType>
+size_t RobinHoodBuckets<DataType, KeyType>::getMemoryBytes() const
+{
+	return sizeof( *this ) + bucketCount * sizeof( Slot ) + occupied.getMemoryBytes();
+}
+
+/**
+ * Find Slot.
+ * 
+ * This function finds the slot that holds searchKey.
+ * 
+ * @param unsigned int hashValue.
+ * @param LookupKey searchKey passed by const reference.
+ * 
+ * @return The index of the slot, or EMPTY if the key is not stored.
+ * 
+ * @note ALGORITHM: The search starts at the home slot and walks forward
+ * one slot at a time while counting its own distance from home.  An empty
+ * slot, or an item that is closer to its home than the search is, means
+ * that the key is not stored, because Robin Hood insertion would have
+ * placed the key in front of that item.  The stored hash values are
+ * compared before the keys so that most mismatches never touch the key.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename LookupKey>
+int RobinHoodBuckets<DataType, KeyType>::findSlot( unsigned int hashValue, const LookupKey& searchKey ) const
+{
+	int index = hashToBucket( hashValue, bucketCount - 1 );
+
+	for( int distance = 0; slots[ index ].distance >= distance; distance++ )
+	{
+		if( slots[ index ].hashValue == hashValue
+		    && slots[ index ].dataItem.getKey() == searchKey )
+		{
+			return index;
+		}
+
+		index = ( index + 1 ) & ( bucketCount - 1 );
+	}
+
+	return EMPTY;
+}
+
+/**
+ * Place.
+ * 
+ * This function places an item whose key is not yet stored into the slots.
+ * 
+ * @pre The key of newDataItem is not stored and there is an empty slot.
+ * @post The slots contain the new item.
+ * 
+ * @param unsigned int hashValue.
+ * @param Item newDataItem passed by forwarding reference; it is copied
+ * from if it is an lvalue and moved from if it is an rvalue.
+ * 
+ * @note ALGORITHM: The item walks forward from its home slot.  Whenever it
+ * finds an item that is closer to its own home than the walking item is,
+ * the two are swapped and the displaced item continues the walk.  This
+ * keeps the probe lengths of all items close to the average.  The walk
+ * ends at the first empty slot.
+ * 
+ */
+template <typename DataType, typename KeyType>
+template <typename Item>
+void RobinHoodBuckets<DataType, KeyType>::place( unsigned int hashValue, Item&& newDataItem )
+{
+	Slot carry;
+	int index = hashToBucket( hashValue, bucketCount - 1 );
+
+	carry.dataItem = std::forward<Item>( newDataItem );
+	carry.hashValue = hashValue;
+	carry.distance = 0;
+
+	while( slots[ index ].distance != EMPTY )
+	{
+		if( slots[ index ].distance < carry.distance )
+		{
+			swap( slots[ index ], carry );
+		}
+
+		carry.distance++;
+		index = ( index + 1 ) & ( bucketCount - 1 );
+	}
+
+	slots[ index ] = std::move( carry );
+	occupied.set( index );
+}
+
+/**
+ * Erase.
+ * 
+ * This function empties a slot that is in use.
+ * 
+ * @pre The slot at index is in use.
+ * @post The slots hold one item less.
+ * 
+ * @param int index.
+ * 
+ * @note ALGORITHM: Robin Hood tables do not need tombstones.  Every item
+ * following the erased slot that is not in its home slot is shifted back
+ * by one slot and its distance is decremented.  The shifting stops at the
+ * first empty slot or the first item that is in its home slot, and the
+ * last slot that was moved from is emptied.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void RobinHoodBuckets<DataType, KeyType>::erase( int index )
+{
+	int next = ( index + 1 ) & ( bucketCount - 1 );
+
+	while( slots[ next ].distance > 0 )
+	{
+		slots[ index ] = std::move( slots[ next ] );
+		slots[ index ].distance--;
+
+		index = next;
+		next = ( next + 1 ) & ( bucketCount - 1 );
+	}
+
+	slots[ index ] = Slot();
+	occupied.reset( index );
+	count--;
+}
+
+/**
+ * Grow.
+ * 
+ * This function doubles the number of slots and places every stored item
+ * again using its stored hash value.
+ * 
+ * @pre The slots are nearly full.
+ * @post The slots are twice as large and hold the same items.
+ * 
+ */
+template <typename DataType, typename KeyType>
+void RobinHoodBuckets<DataType, KeyType>::grow()
+{
+	Slot* oldSlots = slots;
+	int oldBucketCount = bucketCount;
+
+	bucketCount = oldBucketCount * 2;
+	slots = new Slot[ bucketCount ];
+	occupied = BucketBitmap( bucketCount );
+
+	for( int i = 0; i < oldBucketCount; i++ )
+	{
+		if( oldSlots[ i ].distance != EMPTY )
+		{
+			place( oldSlots[ i ].hashValue, std::move( oldSlots[ i ].dataItem ) );
+		}
+	}
+
+	delete[]oldSlots;
+}
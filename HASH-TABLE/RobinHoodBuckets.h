@@ -0,0 +1,97 @@
+// RobinHoodBuckets.h
+
+#ifndef ROBINHOODBUCKETS_H
+#define ROBINHOODBUCKETS_H
+
+#include <stdexcept>
+#include <iostream>
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+#include "HashFunctions.h"
+#include "BucketBitmap.h"
+
+// Bucket storage policy for HashTable: open addressing over one flat
+// array of slots using Robin Hood linear probing.  Every slot keeps the
+// full hash value of its item and how far the item sits from its home
+// slot, so a lookup compares hashes before keys and stops as soon as it
+// reaches an item that is closer to home than the search would be.
+template <typename DataType, typename KeyType>
+class RobinHoodBuckets {
+  public:
+    RobinHoodBuckets(int initBucketCount);
+    RobinHoodBuckets(const RobinHoodBuckets& other);
+    RobinHoodBuckets& operator=(const RobinHoodBuckets& other);
+
+    ~RobinHoodBuckets();
+
+    template <typename Item>
+    bool insert(unsigned int hashValue, Item&& newDataItem);
+    bool remove(unsigned int hashValue, const KeyType& deleteKey);
+    template <typename LookupKey>
+    const DataType* find(unsigned int hashValue, const LookupKey& searchKey) const;
+    void prefetch(unsigned int hashValue) const;
+    void clear();
+
+    bool isEmpty() const;
+
+    int getBucketCount() const;
+    void writeKeys(int bucket) const;
+
+    bool takeItem(int bucket, DataType& returnItem);
+
+    // Removes every item for which pred(item) is true
+    template <typename Predicate>
+    int eraseIf(Predicate& pred);
+
+    // Iteration over the items: first() and next() return NULL at the end
+    class Cursor;
+    const DataType* first(Cursor& cursor) const;
+    const DataType* next(Cursor& cursor) const;
+
+    static double defaultMaxLoadFactor();
+
+    // Statistics: the vector functions append one entry per bucket/item
+    void getBucketLengths(vector<int>& lengths) const;
+    void getBucketHeights(vector<int>& heights) const;
+    void getHitProbes(vector<int>& probes) const;
+    int probeCount(unsigned int hashValue, const KeyType& searchKey) const;
+    size_t getMemoryBytes() const;
+
+  private:
+    class Slot {
+      public:
+	Slot();
+
+	DataType dataItem;
+	unsigned int hashValue;
+	int distance;		// Probes from the home slot, EMPTY if unused
+    };
+
+    static const int EMPTY = -1;
+
+    template <typename LookupKey>
+    int findSlot(unsigned int hashValue, const LookupKey& searchKey) const;
+    template <typename Item>
+    void place(unsigned int hashValue, Item&& newDataItem);
+    void erase(int index);
+    void grow();
+
+    int bucketCount;
+    int count;
+    Slot* slots;
+    BucketBitmap occupied;		// Slots in use
+
+  public:
+    // Position of an iteration: the slot of the current item
+    class Cursor {
+      private:
+	friend class RobinHoodBuckets;
+
+	int slot;
+    };
+};
+
+#endif	// ifndef ROBINHOODBUCKETS_H
@@ -0,0 +1,515 @@
+/**
+ * @file StringHashTable.cpp
+ * @author Amardeep Singh
+ * @brief This program implements a hash table of string keys and string
+ * values that keeps all of its bytes in one arena.
+*/
+#include "StringHashTable.h"
+
+/**
+ * Constructor.
+ * 
+ * The constructor allocates enough slots to hold initTableSize items
+ * without growing.  The slot count is rounded up to a power of two.
+ * 
+ * @pre none
+ * @post An empty table exists.
+ * 
+ * @param int initTableSize.
+ * 
+ */
+StringHashTable::StringHashTable( int initTableSize )
+{
+	Slot empty = { 0, EMPTY_SLOT, 0, 0, 0 };
+	
+	slots.assign( roundUpToPowerOfTwo( initTableSize + initTableSize / 3 + 1 ), empty );
+	count = 0;
+	deadBytes = 0;
+}
+
+/**
+ * Insert.
+ * 
+ * This function stores value under key.  A new item's key and value are
+ * appended to the arena.  If the key is already stored, the new value
+ * overwrites the old one in place when it fits and is appended otherwise.
+ * 
+ * @pre The key and value are each at most MAX_LENGTH bytes.
+ * @post The table maps key to value.
+ * 
+ * @param const char* key.
+ * @param size_t keyLength.
+ * @param const char* value.
+ * @param size_t valueLength.
+ * 
+ * @exception logic_error if the key or value is too long, or the arena
+ * would pass 4 GB.
+ * 
+ */
+void StringHashTable::insert( const char* key, size_t keyLength, const char* value, size_t valueLength )
+{
+	if( keyLength > MAX_LENGTH || valueLength > MAX_LENGTH )
+	{
+		throw logic_error( "StringHashTable key or value too long" );
+	}
+	
+	unsigned int hashValue = StringHash()( key, keyLength );
+	int index = findSlot( hashValue, key, keyLength );
+	
+	if( index >= 0 )
+	{
+		Slot& slot = slots[ index ];
+		
+		if( valueLength <= slot.valueLength )
+		{
+			if( valueLength > 0 )
+			{
+				memcpy( arena.data() + slot.offset + slot.keyLength, value, valueLength );
+			}
+			
+			deadBytes += slot.valueLength - valueLength;
+		}
+		else
+		{
+			deadBytes += slot.keyLength + slot.valueLength;
+			slot.offset = append( key, keyLength, value, valueLength );
+		}
+		
+		slot.valueLength = valueLength;
+		
+		if( deadBytes > arena.size() / 2 )
+		{
+			compact();
+		}
+		
+		return;
+	}
+	
+	if( ( count + 1 ) * 4 > int( slots.size() ) * 3 )
+	{
+		grow();
+	}
+	
+	unsigned int mask = slots.size() - 1;
+	unsigned int probe = hashToBucket( hashValue, mask );
+	
+	while( slots[ probe ].offset != EMPTY_SLOT )
+	{
+		probe = ( probe + 1 ) & mask;
+	}
+	
+	slots[ probe ].offset = append( key, keyLength, value, valueLength );
+	slots[ probe ].hashValue = hashValue;
+	slots[ probe ].keyLength = keyLength;
+	slots[ probe ].valueLength = valueLength;
+	slots[ probe ].prefix = keyPrefix( key, keyLength );
+	count++;
+}
+
+/**
+ * Insert.
+ * 
+ * This function stores value under key.
+ * 
+ * @param string key passed by const reference.
+ * @param string value passed by const reference.
+ * 
+ */
+void StringHashTable::insert( const string& key, const string& value )
+{
+	insert( key.data(), key.length(), value.data(), value.length() );
+}
+
+/**
+ * Remove.
+ * 
+ * This function removes key and its value from the table.  The arena
+ * bytes of the item become dead, and once more than half of the arena is
+ * dead it is compacted.
+ * 
+ * @pre none
+ * @post The key is not stored.
+ * 
+ * @param const char* key.
+ * @param size_t keyLength.
+ * 
+ * @return bool true if the key was stored.
+ * 
+ */
+bool StringHashTable::remove( const char* key, size_t keyLength )
+{
+	int index = findSlot( StringHash()( key, keyLength ), key, keyLength );
+	
+	if( index < 0 )
+	{
+		return false;
+	}
+	
+	deadBytes += slots[ index ].keyLength + slots[ index ].valueLength;
+	erase( index );
+	count--;
+	
+	if( deadBytes > arena.size() / 2 )
+	{
+		compact();
+	}
+	
+	return true;
+}
+
+/**
+ * Remove.
+ * 
+ * @param string key passed by const reference.
+ * 
+ * @return bool true if the key was stored.
+ * 
+ */
+bool StringHashTable::remove( const string& key )
+{
+	return remove( key.data(), key.length() );
+}
+
+/**
+ * Find.
+ * 
+ * This function searches the table for a key.  The value is returned as
+ * a pointer into the arena, so nothing is copied.
+ * 
+ * @pre none
+ * @post If the key is stored then value points to its bytes, which stay
+ * valid until the next insert, remove or clear.
+ * 
+ * @param const char* key.
+ * @param size_t keyLength.
+ * @param const char* value passed by reference.
+ * @param size_t valueLength passed by reference.
+ * 
+ * @return bool
+ * 
+ */
+bool StringHashTable::find( const char* key, size_t keyLength, const char*& value, size_t& valueLength ) const
+{
+	int index = findSlot( StringHash()( key, keyLength ), key, keyLength );
+	
+	if( index < 0 )
+	{
+		return false;
+	}
+	
+	value = arena.data() + slots[ index ].offset + slots[ index ].keyLength;
+	valueLength = slots[ index ].valueLength;
+	return true;
+}
+
+/**
+ * Retrieve.
+ * 
+ * This function searches for a key and copies its value into a string.
+ * 
+ * @param string key passed by const reference.
+ * @param string value passed by reference.
+ * 
+ * @return bool
+ * 
+ */
+bool StringHashTable::retrieve( const string& key, string& value ) const
+{
+	const char* valueBytes;
+	size_t valueLength;
+	
+	if( !find( key.data(), key.length(), valueBytes, valueLength ) )
+	{
+		return false;
+	}
+	
+	value.assign( valueBytes, valueLength );
+	return true;
+}
+
+/**
+ * Clear.
+ * 
+ * This function empties the table.  The slots and arena keep their
+ * capacity.
+ * 
+ * @pre none
+ * @post The table is empty.
+ * 
+ */
+void StringHashTable::clear()
+{
+	Slot empty = { 0, EMPTY_SLOT, 0, 0, 0 };
+	
+	slots.assign( slots.size(), empty );
+	arena.clear();
+	count = 0;
+	deadBytes = 0;
+}
+
+/**
+ * isEmpty
+ * 
+ * @return bool true if the table holds no items.
+ * 
+ */
+bool StringHashTable::isEmpty() const
+{
+	return ( count == 0 );
+}
+
+/**
+ * Get Count.
+ * 
+ * @return The number of items in the table.
+ * 
+ */
+int StringHashTable::getCount() const
+{
+	return count;
+}
+
+/**
+ * Get Bucket Count.
+ * 
+ * @return The number of slots.
+ * 
+ */
+int StringHashTable::getBucketCount() const
+{
+	return slots.size();
+}
+
+/**
+ * Get Load Factor.
+ * 
+ * @return The number of items per slot.
+ * 
+ */
+double StringHashTable::getLoadFactor() const
+{
+	return double( count ) / slots.size();
+}
+
+/**
+ * Show Structure.
+ * 
+ * This function prints every slot with the key stored in it, in the same
+ * form as HashTable::showStructure.
+ * 
+ * @pre none
+ * @post The slots are written to cout.
+ * 
+ */
+void StringHashTable::showStructure() const
+{
+	for( unsigned int i = 0; i < slots.size(); i++ )
+	{
+		cout << i << ": ";
+		
+		if( slots[ i ].offset != EMPTY_SLOT )
+		{
+			cout.write( arena.data() + slots[ i ].offset, slots[ i ].keyLength );
+			cout << ' ';
+		}
+		
+		cout << endl;
+	}
+}
+
+/**
+ * Get Memory Bytes.
+ * 
+ * @return The bytes allocated for the slots and the arena.
+ * 
+ */
+size_t StringHashTable::getMemoryBytes() const
+{
+	return sizeof( *this ) + slots.capacity() * sizeof( Slot ) + arena.capacity();
+}
+
+/**
+ * Key Prefix.
+ * 
+ * This function packs the first four bytes of a key, padded with zeros,
+ * into one word.  Together with the key length it tells apart most keys
+ * that share a hash value without reading the arena.
+ * 
+ * @return uint32_t.
+ * 
+ */
+uint32_t StringHashTable::keyPrefix( const char* key, size_t keyLength )
+{
+	uint32_t prefix = 0;
+	
+	memcpy( &prefix, key, ( keyLength < sizeof( prefix ) ) ? keyLength : sizeof( prefix ) );
+	return prefix;
+}
+
+/**
+ * Find Slot.
+ * 
+ * This function walks the probe sequence of a key until it reaches the
+ * key or an unused slot.
+ * 
+ * @pre The hash value was computed from key.
+ * @post none
+ * 
+ * @return The index of the slot, or -1 if the key is not stored.
+ * 
+ * @note ALGORITHM: The hash value, length and prefix held in the slot are
+ * compared first.  Only when all of them match is the rest of the key
+ * compared with the bytes in the arena.
+ * 
+ */
+int StringHashTable::findSlot( unsigned int hashValue, const char* key, size_t keyLength ) const
+{
+	unsigned int mask = slots.size() - 1;
+	uint32_t prefix = keyPrefix( key, keyLength );
+	
+	for( unsigned int index = hashToBucket( hashValue, mask );
+	     slots[ index ].offset != EMPTY_SLOT;
+	     index = ( index + 1 ) & mask )
+	{
+		const Slot& slot = slots[ index ];
+		
+		if( slot.hashValue == hashValue && slot.keyLength == keyLength
+		    && slot.prefix == prefix
+		    && ( keyLength <= sizeof( prefix )
+		         || memcmp( arena.data() + slot.offset, key, keyLength ) == 0 ) )
+		{
+			return index;
+		}
+	}
+	
+	return -1;
+}
+
+/**
+ * Append.
+ * 
+ * This function copies a key and its value to the end of the arena.
+ * 
+ * @return The arena offset of the key.
+ * 
+ * @exception logic_error if the arena would pass 4 GB.
+ * 
+ */
+uint32_t StringHashTable::append( const char* key, size_t keyLength, const char* value, size_t valueLength )
+{
+	size_t offset = arena.size();
+	
+	if( offset + keyLength + valueLength >= EMPTY_SLOT )
+	{
+		throw logic_error( "StringHashTable arena full" );
+	}
+	
+	arena.insert( arena.end(), key, key + keyLength );
+	arena.insert( arena.end(), value, value + valueLength );
+	
+	return offset;
+}
+
+/**
+ * Erase.
+ * 
+ * This function empties one slot without breaking the probe sequence of
+ * any other key.
+ * 
+ * @pre The slot is in use.
+ * @post The slot's item is gone.
+ * 
+ * @param unsigned int index.
+ * 
+ * @note ALGORITHM: The slots after the hole are scanned up to the next
+ * unused slot.  An item whose home slot is not cyclically between the
+ * hole and the item is moved back into the hole, which then moves to
+ * where that item was.
+ * 
+ */
+void StringHashTable::erase( unsigned int index )
+{
+	unsigned int mask = slots.size() - 1;
+	unsigned int next = ( index + 1 ) & mask;
+	
+	while( slots[ next ].offset != EMPTY_SLOT )
+	{
+		unsigned int home = hashToBucket( slots[ next ].hashValue, mask );
+		
+		if( ( ( next - home ) & mask ) >= ( ( next - index ) & mask ) )
+		{
+			slots[ index ] = slots[ next ];
+			index = next;
+		}
+		
+		next = ( next + 1 ) & mask;
+	}
+	
+	slots[ index ].offset = EMPTY_SLOT;
+}
+
+/**
+ * Grow.
+ * 
+ * This function doubles the slot count.  The items keep their hash
+ * values, so they are placed again without rehashing any keys, and the
+ * arena does not change.
+ * 
+ * @pre none
+ * @post The slot count is twice as large.
+ * 
+ */
+void StringHashTable::grow()
+{
+	Slot empty = { 0, EMPTY_SLOT, 0, 0, 0 };
+	vector<Slot> oldSlots( slots.size() * 2, empty );
+	unsigned int mask = oldSlots.size() - 1;
+	
+	oldSlots.swap( slots );
+	
+	for( unsigned int i = 0; i < oldSlots.size(); i++ )
+	{
+		if( oldSlots[ i ].offset != EMPTY_SLOT )
+		{
+			unsigned int index = hashToBucket( oldSlots[ i ].hashValue, mask );
+			
+			while( slots[ index ].offset != EMPTY_SLOT )
+			{
+				index = ( index + 1 ) & mask;
+			}
+			
+			slots[ index ] = oldSlots[ i ];
+		}
+	}
+}
+
+/**
+ * Compact.
+ * 
+ * This function copies the live keys and values into a new arena, which
+ * drops the dead bytes left by removes and replaced values.
+ * 
+ * @pre none
+ * @post No arena bytes are dead.
+ * 
+ */
+void StringHashTable::compact()
+{
+	vector<char> newArena;
+	
+	newArena.reserve( arena.size() - deadBytes );
+	
+	for( unsigned int i = 0; i < slots.size(); i++ )
+	{
+		if( slots[ i ].offset != EMPTY_SLOT )
+		{
+			const char* bytes = arena.data() + slots[ i ].offset;
+			
+			slots[ i ].offset = newArena.size();
+			newArena.insert( newArena.end(), bytes, bytes + slots[ i ].keyLength + slots[ i ].valueLength );
+		}
+	}
+	
+	arena.swap( newArena );
+	deadBytes = 0;
+}
@@ -0,0 +1,79 @@
+// StringHashTable.h
+
+#ifndef STRINGHASHTABLE_H
+#define STRINGHASHTABLE_H
+
+#include <stdexcept>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+using namespace std;
+
+#include "HashFunctions.h"
+
+// Hash table specialised for string keys and string values, such as
+// usernames and passwords.  Instead of one allocated node and two string
+// objects per item, every key and value is copied into one contiguous
+// byte arena and each item is a 16 byte slot in a flat array:
+//   hash value, arena offset, key and value lengths, and the first four
+//   bytes of the key
+// A lookup compares the hash value, length and key prefix in the slot
+// before it touches the arena, so a miss almost never leaves the slot
+// array and keys of four bytes or less are never read from the arena.
+// Items are placed by linear probing from hashToBucket(StringHash(key)).
+class StringHashTable {
+  public:
+    StringHashTable(int initTableSize);
+
+    void insert(const char* key, size_t keyLength,
+                const char* value, size_t valueLength);
+    void insert(const string& key, const string& value);
+    bool remove(const char* key, size_t keyLength);
+    bool remove(const string& key);
+    bool find(const char* key, size_t keyLength,
+              const char*& value, size_t& valueLength) const;
+    bool retrieve(const string& key, string& value) const;
+    void clear();
+
+    bool isEmpty() const;
+    int getCount() const;
+    int getBucketCount() const;
+    double getLoadFactor() const;
+
+    void showStructure() const;
+
+    // Bytes held by the slots and the arena, including unused capacity
+    size_t getMemoryBytes() const;
+
+    // Keys and values are limited to MAX_LENGTH bytes each
+    static const size_t MAX_LENGTH = 0xFFFF;
+
+  private:
+    struct Slot {
+	uint32_t hashValue;
+	uint32_t offset;		// EMPTY_SLOT if the slot is unused
+	uint16_t keyLength;
+	uint16_t valueLength;
+	uint32_t prefix;		// First key bytes, zero padded
+    };
+
+    static const uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+
+    static uint32_t keyPrefix(const char* key, size_t keyLength);
+    int findSlot(unsigned int hashValue, const char* key,
+                 size_t keyLength) const;
+    uint32_t append(const char* key, size_t keyLength,
+                    const char* value, size_t valueLength);
+    void erase(unsigned int index);
+    void grow();
+    void compact();
+
+    vector<Slot> slots;
+    vector<char> arena;
+    int count;
+    size_t deadBytes;		// Arena bytes no slot refers to
+};
+
+#endif	// ifndef STRINGHASHTABLE_H
@@ -0,0 +1,148 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 10                                         batch10.cpp
+//
+//  Benchmark for HashTable::retrieveMany.  Tables of username/password
+//  pairs of several sizes are loaded, and batches of 256 random users
+//  are authenticated, first with a loop of find calls and then with
+//  one retrieveMany call per batch.
+//
+//  Build:  g++ -O2 batch10.cpp -o batch10
+//  Usage:  batch10 [largest table size]
+//          The largest table holds 1000000 users by default.
+//
+//--------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+#include <chrono>
+#include "HashTable.cpp"
+
+using namespace std;
+
+struct Password
+{
+    void setKey ( string newKey ) { username = newKey; }
+    const string& getKey () const { return username; }
+
+    string username,
+           password;
+};
+
+const int batchSize = 256;
+const int lookupsPerRun = 4000000;
+
+//--------------------------------------------------------------------
+
+// Nanoseconds per lookup over lookupsPerRun lookups, with the batches
+// taken in turn from batches.  Both ways count the passwords that match
+// so that neither loop can be optimised away.
+template <typename Table>
+double timeLookups ( const Table& table, const vector< vector<string> >& batches,
+                     const vector< vector<string> >& passwords,
+                     bool batched, int& matched )
+{
+    vector<const Password*> results;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    matched = 0;
+
+    for ( int done = 0, b = 0; done < lookupsPerRun; done += batchSize )
+    {
+        const vector<string>& keys = batches[b];
+
+        if ( batched )
+        {
+            table.retrieveMany( keys, results );
+        }
+        else
+        {
+            results.resize( keys.size() );
+            for ( unsigned int i = 0; i < keys.size(); i++ )
+                results[i] = table.find( keys[i] );
+        }
+
+        for ( unsigned int i = 0; i < keys.size(); i++ )
+            if ( results[i] != NULL && results[i]->password == passwords[b][i] )
+                matched++;
+
+        b = ( b + 1 ) % batches.size();
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    return elapsed.count() * 1e9 / lookupsPerRun;
+}
+
+template <template <typename, typename> class Buckets>
+void runSize ( const char* name, const vector<Password>& users, int tableSize )
+{
+    HashTable<Password, string, Buckets, StringHash> table( 8 );
+    vector< vector<string> > batches( 64 ), passwords( 64 );
+    int scalarMatched, batchedMatched;
+
+    table.bulkLoad( users.begin(), users.begin() + tableSize );
+
+    for ( unsigned int b = 0; b < batches.size(); b++ )
+    {
+        for ( int i = 0; i < batchSize; i++ )
+        {
+            const Password& user = users[ rand() % tableSize ];
+
+            batches[b].push_back( user.username );
+            passwords[b].push_back( user.password );
+        }
+    }
+
+    double scalar = timeLookups( table, batches, passwords, false, scalarMatched );
+    double batched = timeLookups( table, batches, passwords, true, batchedMatched );
+
+    cout << setw(12) << left << name << right
+         << setw(10) << tableSize
+         << setw(12) << fixed << setprecision(1) << scalar
+         << setw(12) << batched
+         << setw(10) << setprecision(2) << scalar / batched << "x"
+         << ( scalarMatched == batchedMatched ? "" : "  MISMATCH" ) << endl;
+}
+
+int main ( int argc, char **argv )
+{
+    int largest = ( argc > 1 ) ? atoi( argv[1] ) : 1000000;
+    vector<Password> users( largest );
+
+    srand( 10 );
+
+    for ( int i = 0; i < largest; i++ )
+    {
+        ostringstream name, pass;
+
+        name << "user" << rand() % 1000 << "_" << i;
+        pass << "pw" << rand() % 1000000;
+        users[i].username = name.str();
+        users[i].password = pass.str();
+    }
+
+    cout << setw(12) << left << "Buckets" << right
+         << setw(10) << "Users"
+         << setw(12) << "find ns"
+         << setw(12) << "many ns"
+         << setw(11) << "speedup" << endl;
+
+    for ( int size = 1000; ; size *= 32 )
+    {
+        if ( size > largest )
+            size = largest;
+
+        runSize<ChainedBuckets>( "Chained", users, size );
+        runSize<RobinHoodBuckets>( "Robin Hood", users, size );
+
+        if ( size == largest )
+            break;
+    }
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 10                                       bench10mt.cpp
+//
+//  Throughput benchmark for the ConcurrentHashTable.  A table of
+//  username/password pairs is loaded and then 1 to N threads (N is the
+//  number of cores) run authentication lookups against it, with one
+//  password change for every twenty lookups.
+//
+//  Build:  g++ -O2 -std=c++17 -pthread bench10mt.cpp -o bench10mt
+//  Usage:  bench10mt [password file]
+//          Without a file, 200000 synthetic users are generated.
+//
+//--------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include "ConcurrentHashTable.cpp"
+
+using namespace std;
+
+struct Password
+{
+    void setKey ( string newKey ) { username = newKey; }
+    string getKey () const { return username; }
+
+    string username,
+           password;
+};
+
+const int opsPerThread = 2000000;
+
+typedef ConcurrentHashTable<Password, string, RobinHoodBuckets, StringHash> PasswordTable;
+
+//--------------------------------------------------------------------
+
+void worker ( PasswordTable& table, const vector<Password>& users,
+              unsigned int seed, int& found )
+{
+    Password entry;
+    unsigned int next = seed;
+
+    found = 0;
+
+    for ( int i = 0; i < opsPerThread; i++ )
+    {
+        next = next * 1103515245 + 12345;
+        const Password& user = users[ ( next >> 8 ) % users.size() ];
+
+        if ( i % 20 == 19 )
+        {
+            table.insert( user );
+        }
+        else if ( table.retrieve( user.username, entry )
+                  && entry.password == user.password )
+        {
+            found++;
+        }
+    }
+}
+
+int main ( int argc, char **argv )
+{
+    vector<Password> users;
+    Password tempPass;
+
+    if ( argc > 1 )
+    {
+        ifstream passFile( argv[1] );
+
+        if ( !passFile )
+        {
+            cout << "Unable to open '" << argv[1] << "'!" << endl;
+            return 1;
+        }
+
+        while ( passFile >> tempPass.username >> tempPass.password )
+            users.push_back( tempPass );
+    }
+    else
+    {
+        for ( int i = 0; i < 200000; i++ )
+        {
+            ostringstream name, pass;
+            name << "user" << i;
+            pass << "pw" << ( i * 7919 ) % 100003;
+            tempPass.username = name.str();
+            tempPass.password = pass.str();
+            users.push_back( tempPass );
+        }
+    }
+
+    if ( users.empty() )
+    {
+        cout << "No users to load" << endl;
+        return 1;
+    }
+
+    PasswordTable table( users.size() );
+
+    for ( unsigned int i = 0; i < users.size(); i++ )
+        table.insert( users[i] );
+
+    unsigned int cores = thread::hardware_concurrency();
+    if ( cores == 0 )
+        cores = 1;
+
+    cout << users.size() << " users, " << table.getShardCount()
+         << " shards, " << opsPerThread << " operations per thread" << endl;
+    cout << setw(8) << "threads" << setw(14) << "Mops/sec"
+         << setw(10) << "speedup" << endl;
+
+    double baseRate = 0;
+
+    for ( unsigned int threads = 1; threads <= cores;
+          threads = ( threads * 2 > cores && threads < cores ) ? cores : threads * 2 )
+    {
+        vector<thread> pool;
+        vector<int> found( threads );
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        for ( unsigned int t = 0; t < threads; t++ )
+            pool.push_back( thread( worker, ref( table ), cref( users ),
+                                    t * 2654435761u + 1, ref( found[t] ) ) );
+        for ( unsigned int t = 0; t < threads; t++ )
+            pool[t].join();
+
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        double rate = threads * double( opsPerThread ) / elapsed.count() / 1e6;
+
+        if ( threads == 1 )
+            baseRate = rate;
+
+        cout << setw(8) << threads << setw(14) << fixed << setprecision(2)
+             << rate << setw(9) << rate / baseRate << "x" << endl;
+    }
+
+    return 0;
+}
@@ -8,6 +8,7 @@
 //--------------------------------------------------------------------
 
 #include <string>
+#include <vector>
 #include <iostream>
 #include <fstream>
 #include "HashTable.cpp"
@@ -19,9 +20,9 @@ using namespace std;
 struct Password
 {
     void setKey ( string newKey ) { username = newKey; }
-    string getKey () const { return username; }
+    const string& getKey () const { return username; }
 	
-		//this hash converts a string to an integer
+		//this hash converts a string to an integer (the table uses StringHash)
     int hash(const string str) const
     {
         int val = 0;
@@ -36,11 +37,12 @@ struct Password
 
 int main()
 {
-    HashTable<Password, string> passwords(8);
+    HashTable<Password, string, RobinHoodBuckets, StringHash> passwords(8);
     Password tempPass;
+    vector<Password> passList;
     string name,      // user-supplied name
            pass;      // user-supplied password
-    bool userFound;   // is user in table?
+    const Password* user;   // user in table, NULL if none
 
 	//*********************************************************
 	// Step 1: Read in the password file
@@ -55,10 +57,13 @@ int main()
 
     while ( passFile >> tempPass.username >> tempPass.password )
     {
-		//**add line here to insert passwords into the HashTbl
-		passwords.insert( tempPass );
+		passList.push_back( tempPass );
     }
 
+		//**add line here to insert passwords into the HashTbl
+		//**(bulkLoad sizes the table once for the whole file)
+	passwords.bulkLoad( passList.begin(), passList.end() );
+
 	//**add line here to show (print) the HashTbl
       passwords.showStructure();
       
@@ -69,7 +74,7 @@ int main()
     while ( cin >> name )  // to quit, type CTRL Z in Visual C++
     {
 		//**add line here to retrieve user from HashTbl
-       userFound = passwords.retrieve( name, tempPass );
+       user = passwords.find( name );
  
         cout << "Password: ";
         cin >> pass;
@@ -77,7 +82,7 @@ int main()
 		//**add lines here to compare retrieved user password to 
 		//**input password and print "Authentication failure"
 		//**or "Authentication successful"
-		if( tempPass.password == pass && userFound )
+		if( user != NULL && user->password == pass )
 		{
 			cout << "Authentication successful" << endl;
 		}
@@ -87,7 +92,6 @@ int main()
 		}
 		
         cout << "Login: ";
-        userFound = false;
     }
     
     cout << endl;
@@ -0,0 +1,139 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 10                                          mem10.cpp
+//
+//  Loads the same username/password pairs into a HashTable of
+//  Password items, once with each bucket policy, and into a
+//  StringHashTable, then prints the heap bytes each one uses and how
+//  long it takes to retrieve every user.
+//
+//  Usage:  mem10 [user count]
+//          200000 synthetic users are generated by default.
+//
+//--------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+#include <chrono>
+#include <malloc.h>
+#include "HashTable.cpp"
+#include "StringHashTable.cpp"
+
+using namespace std;
+
+struct Password
+{
+    void setKey ( string newKey ) { username = newKey; }
+    const string& getKey () const { return username; }
+
+    string username,
+           password;
+};
+
+// Bytes allocated on the heap right now, including large blocks that
+// malloc maps separately (glibc)
+size_t heapBytes ()
+{
+    struct mallinfo2 info = mallinfo2();
+
+    return info.uordblks + info.hblkhd;
+}
+
+void printRow ( const char* name, size_t bytes, int users,
+                double seconds, int found )
+{
+    cout << setw(22) << left << name << right
+         << setw(12) << bytes
+         << setw(12) << fixed << setprecision(1) << double(bytes) / users
+         << setw(12) << setprecision(1) << seconds * 1e9 / users
+         << setw(10) << found << endl;
+}
+
+template <template <typename, typename> class Buckets>
+void measureHashTable ( const char* name, const vector<Password>& users )
+{
+    size_t before = heapBytes();
+    HashTable<Password, string, Buckets, StringHash>* table
+        = new HashTable<Password, string, Buckets, StringHash>( 8 );
+
+    table->bulkLoad( users.begin(), users.end() );
+
+    size_t bytes = heapBytes() - before;
+    int found = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for ( unsigned int i = 0; i < users.size(); i++ )
+    {
+        const Password* user = table->find( users[i].username );
+
+        if ( user != NULL && user->password.length() > 0 )
+            found++;
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    printRow( name, bytes, users.size(), elapsed.count(), found );
+    delete table;
+}
+
+void measureStringHashTable ( const vector<Password>& users )
+{
+    size_t before = heapBytes();
+    StringHashTable* table = new StringHashTable( users.size() );
+
+    for ( unsigned int i = 0; i < users.size(); i++ )
+        table->insert( users[i].username, users[i].password );
+
+    size_t bytes = heapBytes() - before;
+    int found = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for ( unsigned int i = 0; i < users.size(); i++ )
+    {
+        const char* value;
+        size_t valueLength;
+
+        if ( table->find( users[i].username.data(), users[i].username.length(),
+                          value, valueLength ) && valueLength > 0 )
+            found++;
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    printRow( "StringHashTable", bytes, users.size(), elapsed.count(), found );
+    delete table;
+}
+
+int main ( int argc, char* argv[] )
+{
+    int userCount = ( argc > 1 ) ? atoi( argv[1] ) : 200000;
+    vector<Password> users( userCount );
+
+    srand( 10 );
+
+    for ( int i = 0; i < userCount; i++ )
+    {
+        ostringstream name, pass;
+
+        name << "user" << i;
+        pass << "pw" << rand() % 1000000;
+        users[i].username = name.str();
+        users[i].password = pass.str();
+    }
+
+    cout << setw(22) << left << "Table" << right
+         << setw(12) << "Heap bytes"
+         << setw(12) << "Bytes/user"
+         << setw(12) << "ns/lookup"
+         << setw(10) << "Found" << endl;
+
+    measureHashTable<ChainedBuckets>( "HashTable chained", users );
+    measureHashTable<RobinHoodBuckets>( "HashTable Robin Hood", users );
+    measureStringHashTable( users );
+
+    return 0;
+}
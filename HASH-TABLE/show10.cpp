@@ -1,9 +1,17 @@
 // show10.cpp: contains implementation of the HashTable showStructure function
-template <typename DataType, typename KeyType>
-void HashTable<DataType, KeyType>::showStructure() const {
-    for (int i = 0; i < tableSize; ++i) {
+template <typename DataType, typename KeyType, template <typename, typename> class Buckets, typename Hasher>
+void HashTable<DataType, KeyType, Buckets, Hasher>::showStructure() const {
+    for (int i = 0; i < dataTable->getBucketCount(); ++i) {
 	cout << i << ": ";
-	dataTable[i].writeKeys();
+	dataTable->writeKeys(i);
+    }
+
+    if (oldTable != NULL) {
+	cout << "Rehashing, not yet moved:" << endl;
+	for (int i = rehashIndex; i < oldTable->getBucketCount(); ++i) {
+	    cout << i << ": ";
+	    oldTable->writeKeys(i);
+	}
     }
 }
 
@@ -0,0 +1,87 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 10                                          snap10.cpp
+//
+//  Builds a memory-mapped snapshot of a password file and then
+//  authenticates usernames against the snapshot until EOF, the same
+//  way login.cpp does against a HashTable.  Opening the snapshot costs
+//  the same however many users it holds.
+//
+//  Usage:  snap10 build password.dat password.snap
+//          snap10 login password.snap
+//
+//--------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <utility>
+#include "HashSnapshot.cpp"
+
+using namespace std;
+
+int main ( int argc, char **argv )
+{
+    if ( argc == 4 && string( argv[1] ) == "build" )
+    {
+        vector< pair<string, string> > users;
+        pair<string, string> user;
+        ifstream passFile( argv[2] );
+
+        if ( !passFile )
+        {
+            cout << "Unable to open '" << argv[2] << "'!" << endl;
+            return 1;
+        }
+
+        while ( passFile >> user.first >> user.second )
+            users.push_back( user );
+
+        if ( !HashSnapshot::write( argv[3], users.begin(), users.end() ) )
+        {
+            cout << "Unable to write '" << argv[3] << "'!" << endl;
+            return 1;
+        }
+
+        cout << users.size() << " users written to " << argv[3] << endl;
+        return 0;
+    }
+
+    if ( argc != 3 || string( argv[1] ) != "login" )
+    {
+        cout << "Usage: " << argv[0] << " build <password file> <snapshot>" << endl
+             << "       " << argv[0] << " login <snapshot>" << endl;
+        return 1;
+    }
+
+    HashSnapshot passwords;
+    string name,      // user-supplied name
+           pass,      // user-supplied password
+           stored;    // password in the snapshot
+
+    if ( !passwords.open( argv[2] ) )
+    {
+        cout << "Unable to open snapshot '" << argv[2] << "'!" << endl;
+        return 1;
+    }
+
+    cout << "Login: ";
+    while ( cin >> name )
+    {
+        bool userFound = passwords.retrieve( name, stored );
+
+        cout << "Password: ";
+        cin >> pass;
+
+        if ( userFound && stored == pass )
+            cout << "Authentication successful" << endl;
+        else
+            cout << "Authentication failure" << endl;
+
+        cout << "Login: ";
+    }
+
+    cout << endl;
+    return 0;
+}
@@ -0,0 +1,188 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 10                                        stats10.cpp
+//
+//  Compares the hash algorithms of test10std.cpp, plus the byte sum
+//  of login.cpp and the StringHash hasher, by loading the same keys
+//  into a HashTable with each of them and printing the statistics
+//  from HashTable::getStats() side by side.
+//
+//  Usage:  stats10 [key file]
+//          Without a file, 20000 synthetic usernames are generated.
+//          Half of the keys are loaded; the other half are the misses.
+//
+//--------------------------------------------------------------------
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include "HashTable.cpp"
+
+using namespace std;
+
+struct Data
+{
+    void setKey ( string newKey ) { key = newKey; }
+    string getKey () const { return key; }
+
+    string key;
+};
+
+//--------------------------------------------------------------------
+// The hash algorithms being compared
+//--------------------------------------------------------------------
+
+struct ZeroHash                 // Hash Algorithm 1
+{
+    unsigned int operator() ( const string& ) const
+        { return 0; }
+};
+
+struct FirstCharHash            // Hash Algorithm 2
+{
+    unsigned int operator() ( const string& str ) const
+        { return int(str[0])*10 + str.length(); }
+};
+
+struct GrowingSumHash           // Hash Algorithm 3
+{
+    unsigned int operator() ( const string& str ) const
+    {
+        double val = 0;
+        for (unsigned int i=0; i<str.length(); i++)
+            val += (val*1.1)+str[i];
+        return (unsigned int) fmod( val, 4294967296.0 );  // int(val) overflows
+    }
+};
+
+struct ByteSumHash              // Password::hash from login.cpp
+{
+    unsigned int operator() ( const string& str ) const
+    {
+        unsigned int val = 0;
+        for (unsigned int i=0; i<str.length(); i++)
+            val += str[i];
+        return val;
+    }
+};
+
+//--------------------------------------------------------------------
+
+template < template <typename, typename> class Buckets, typename Hasher >
+void report ( const string& name, const vector<Data>& items,
+              const vector<string>& missKeys )
+{
+    HashTable<Data, string, Buckets, Hasher> table(64);
+
+    table.bulkLoad( items.begin(), items.end() );
+
+    HashTableStats stats = table.getStats( missKeys.begin(), missKeys.end() );
+    int tallest = 0;
+
+    for ( unsigned int i = 0; i < stats.bucketHeights.size(); i++ )
+        if ( stats.bucketHeights[i] > tallest )
+            tallest = stats.bucketHeights[i];
+
+    // Slot-based buckets have no trees and report no heights.
+    ostringstream height;
+    if ( stats.bucketHeights.empty() )
+        height << "-";
+    else
+        height << tallest;
+
+    cout << left << setw(24) << name << right
+         << setw(8) << stats.bucketCount
+         << setw(8) << stats.usedBuckets
+         << setw(8) << stats.maxChainLength
+         << setw(8) << height.str()
+         << setw(9) << fixed << setprecision(2) << stats.standardDeviation
+         << setw(8) << stats.hits.mean << setw(6) << stats.hits.p99
+         << setw(8) << stats.misses.mean << setw(6) << stats.misses.p99
+         << setw(8) << setprecision(1) << stats.bytesPerItem << endl;
+}
+
+void printLengthHistogram ( const vector<Data>& items )
+{
+    HashTable<Data, string, ChainedBuckets, StringHash> table(64);
+
+    table.bulkLoad( items.begin(), items.end() );
+
+    HashTableStats stats = table.getStats();
+
+    cout << endl << "Bucket lengths with StringHash (length: buckets)" << endl;
+    for ( unsigned int k = 0; k < stats.lengthHistogram.size(); k++ )
+        cout << "  " << k << ": " << stats.lengthHistogram[k] << endl;
+}
+
+int main ( int argc, char **argv )
+{
+    vector<string> keys;
+    vector<Data> items;
+    vector<string> missKeys;
+    string key;
+
+    if ( argc > 1 )
+    {
+        ifstream data( argv[1] );
+
+        if ( !data )
+        {
+            cerr << "Error opening '" << argv[1] << "'" << endl;
+            return 1;
+        }
+
+        while ( data >> key )
+            keys.push_back( key );
+    }
+    else
+    {
+        const char* names[] = { "jack", "jill", "mary", "bopeep", "cole",
+                                "simon", "amy", "raj", "lee", "olga" };
+        unsigned int next = 12345;
+
+        for ( int i = 0; i < 20000; i++ )
+        {
+            ostringstream name;
+            next = next * 1103515245 + 12345;
+            name << names[ ( next >> 16 ) % 10 ] << ( next >> 8 ) % 100000;
+            keys.push_back( name.str() );
+        }
+    }
+
+    for ( unsigned int i = 0; i < keys.size(); i++ )
+    {
+        if ( i % 2 == 0 )
+        {
+            Data item;
+            item.setKey( keys[i] );
+            items.push_back( item );
+        }
+        else
+            missKeys.push_back( keys[i] );
+    }
+
+    cout << items.size() << " keys loaded, " << missKeys.size()
+         << " miss keys" << endl << endl;
+    cout << left << setw(24) << "algorithm" << right
+         << setw(8) << "buckets" << setw(8) << "used" << setw(8) << "maxlen"
+         << setw(8) << "height" << setw(9) << "stddev"
+         << setw(8) << "hit" << setw(6) << "p99"
+         << setw(8) << "miss" << setw(6) << "p99"
+         << setw(8) << "B/item" << endl;
+
+    report<ChainedBuckets, ZeroHash>( "1 zero", items, missKeys );
+    report<ChainedBuckets, FirstCharHash>( "2 first char", items, missKeys );
+    report<ChainedBuckets, GrowingSumHash>( "3 growing sum", items, missKeys );
+    report<ChainedBuckets, ByteSumHash>( "byte sum (login)", items, missKeys );
+    report<ChainedBuckets, StringHash>( "StringHash", items, missKeys );
+    report<RobinHoodBuckets, ByteSumHash>( "byte sum, Robin Hood", items, missKeys );
+    report<RobinHoodBuckets, StringHash>( "StringHash, Robin Hood", items, missKeys );
+
+    printLengthHistogram( items );
+
+    return 0;
+}
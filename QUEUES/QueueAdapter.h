@@ -0,0 +1,70 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 7                                        QueueAdapter.h
+//
+//  Class declaration and implementation of an adapter that gives any
+//  of the queue classes the Queue ADT's abstract interface.
+//
+//--------------------------------------------------------------------
+
+#ifndef QUEUEADAPTER_H
+#define QUEUEADAPTER_H
+
+#include <stdexcept>
+#include <iostream>
+
+using namespace std;
+
+#include "Queue.h"
+
+//--------------------------------------------------------------------
+
+// The queue classes (QueueArray, QueueLinked, QueueSPSC, QueueMPMC) have
+// the operations of Queue<DataType> but do not derive from it, so none of
+// their functions are virtual.  Code that names the class it uses gets
+// every call bound at compile time, where it can be inlined into the
+// caller's loop.  Code that must accept any queue through a
+// Queue<DataType>& wraps the queue in a QueueAdapter, which owns one and
+// forwards each virtual function to it.
+//
+// Only the functions that Queue<DataType> declares are virtual here; the
+// optional ones are plain forwarders when their LAB7_TEST flag is off.
+template <typename DataType, template <typename> class Implementation>
+class QueueAdapter : public Queue<DataType> {
+  public:
+    QueueAdapter(int maxNumber = Queue<DataType>::MAX_QUEUE_SIZE)
+	: queue(maxNumber) {}
+
+    void enqueue(const DataType& newDataItem) throw (logic_error)
+	{ queue.enqueue(newDataItem); }
+    DataType dequeue() throw (logic_error)
+	{ return queue.dequeue(); }
+
+    void clear()
+	{ queue.clear(); }
+
+    bool isEmpty() const
+	{ return queue.isEmpty(); }
+    bool isFull() const
+	{ return queue.isFull(); }
+
+    void putFront(const DataType& newDataItem) throw (logic_error)
+	{ queue.putFront(newDataItem); }
+    DataType getRear() throw (logic_error)
+	{ return queue.getRear(); }
+    int getLength() const
+	{ return queue.getLength(); }
+
+    void showStructure() const
+	{ queue.showStructure(); }
+
+    Implementation<DataType>& getQueue()            // Wrapped queue
+	{ return queue; }
+    const Implementation<DataType>& getQueue() const
+	{ return queue; }
+
+  private:
+    Implementation<DataType> queue;
+};
+
+#endif		// #ifndef QUEUEADAPTER_H
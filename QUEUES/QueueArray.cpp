@@ -0,0 +1,475 @@
+#include <iostream>
+#include <new>
+#include "QueueArray.h"
+
+using namespace std;
+
+/*
+ * name: QueueArray
+ * 
+ * inputParamter: the starting number of items & whether to give memory
+ * back when the queue empties out
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: an empty queue will be created
+ * 
+ * functionAlgorithm: the starting size is maxNumber rounded up to a
+ * power of two, so that a position is turned into a slot by masking
+ * instead of by modulo.  front & back are both set to zero.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+QueueArray<DataType>::QueueArray( int maxNumber, bool shrinkWhenSparse )
+{
+	maxSize = 1;
+
+	while( maxSize < maxNumber && maxSize < MAX_SIZE )
+	{
+		maxSize *= 2;
+	}
+
+	minSize = maxSize;
+	shrink = shrinkWhenSparse;
+	front = back = 0;
+	dataItems = new DataType[ maxSize ];
+}
+
+/*
+ * name: QueueArray ( copy constructor )
+ * 
+ * inputParamter: a queue
+ * 
+ * preCondtion: a source queue must already exist
+ * 
+ * postCondtion: a new queue will be created identical to the source
+ * 
+ * functionAlgorithm: a ring the size of the source's is allocated and
+ * the items are copied over in queue order, starting at slot zero
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+QueueArray<DataType>::QueueArray( const QueueArray &source )
+{
+	maxSize = source.maxSize;
+	minSize = source.minSize;
+	shrink = source.shrink;
+	dataItems = new DataType[ maxSize ];
+	front = 0;
+	back = source.back - source.front;
+
+	for( unsigned int i = 0; i < back; i++ )
+	{
+		dataItems[ i ] = source.dataItems[ ( source.front + i ) & ( maxSize - 1 ) ];
+	}
+}
+
+/*
+ * name: QueueArray overload = operater
+ * 
+ * inputParamter: a queue
+ * 
+ * preCondtion: a source queue must exist
+ * 
+ * postCondtion: the source queue will be assigned to this queue
+ * 
+ * functionAlgorithm: assigning a queue to itself does nothing.  otherwise
+ * a copy of the source is made into a new ring before the old ring is
+ * deleted, so this queue is left as it was if the allocation fails.
+ * 
+ * returnValue: this queue
+*/
+template <typename DataType>
+QueueArray<DataType>& QueueArray<DataType>::operator=( const QueueArray &source )
+{
+	if( this != &source )
+	{
+		DataType* newItems = new DataType[ source.maxSize ];
+		unsigned int length = source.back - source.front;
+
+		for( unsigned int i = 0; i < length; i++ )
+		{
+			newItems[ i ] = source.dataItems[ ( source.front + i ) & ( source.maxSize - 1 ) ];
+		}
+
+		delete[] dataItems;
+		dataItems = newItems;
+		maxSize = source.maxSize;
+		minSize = source.minSize;
+		shrink = source.shrink;
+		front = 0;
+		back = length;
+	}
+
+	return *this;
+}
+
+/*
+ * name: ~QueueArray
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: a queue must exist
+ * 
+ * postCondtion: the ring will be deallocated
+ * 
+ * functionAlgorithm: the ring is deleted
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+QueueArray<DataType>::~QueueArray()
+{
+	delete[] dataItems;
+}
+
+/*
+ * name: resize
+ * 
+ * inputParamter: the new number of slots, a power of two no smaller
+ * than the number of items
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: the items are in a ring of newSize slots, in the same
+ * order, with the front item in slot zero
+ * 
+ * functionAlgorithm: the new ring is allocated first, so that a failed
+ * allocation leaves the queue as it was.  the items are copied over
+ * from front to back & the old ring is deleted.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueArray<DataType>::resize( int newSize )
+{
+	DataType* newItems = new DataType[ newSize ];
+	unsigned int length = back - front;
+
+	for( unsigned int i = 0; i < length; i++ )
+	{
+		newItems[ i ] = dataItems[ ( front + i ) & ( maxSize - 1 ) ];
+	}
+
+	delete[] dataItems;
+	dataItems = newItems;
+	maxSize = newSize;
+	front = 0;
+	back = length;
+}
+
+/*
+ * name: shrinkIfSparse
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: if shrinking is on and the ring is no more than a
+ * quarter full, the ring has been halved
+ * 
+ * functionAlgorithm: halving at a quarter full leaves the new ring half
+ * full, so that a queue moving up & down around one length does not
+ * grow & shrink on every operation.  the ring is never made smaller than
+ * its starting size.  shrinking only gives memory back, so if the
+ * allocation fails the queue keeps its larger ring.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueArray<DataType>::shrinkIfSparse()
+{
+	if( shrink && maxSize > minSize && int( back - front ) <= maxSize / 4 )
+	{
+		try
+		{
+			resize( maxSize / 2 );
+		}
+		catch( bad_alloc& )
+		{
+		}
+	}
+}
+
+/*
+ * name: enqueue
+ * 
+ * inputParamter: a DataType item
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: the item is at the back of the queue
+ * 
+ * functionAlgorithm: if every slot is in use the ring is doubled first.
+ * the item is stored in the slot of the back position, and back is moved
+ * on.  the queue is only full once the ring has reached its largest size
+ * or memory for a larger one cannot be had.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueArray<DataType>::enqueue( const DataType &item ) throw (logic_error)
+{
+	if( int( back - front ) == maxSize )
+	{
+		if( maxSize == MAX_SIZE )
+		{
+			throw logic_error( "enqueue() while queue full" );
+		}
+
+		try
+		{
+			resize( maxSize * 2 );
+		}
+		catch( bad_alloc& )
+		{
+			throw logic_error( "enqueue() while queue full" );
+		}
+	}
+
+	dataItems[ back & ( maxSize - 1 ) ] = item;
+	back++;
+}
+
+/*
+ * name: dequeue
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: the queue must not be empty
+ * 
+ * postCondtion: the front item is removed
+ * 
+ * functionAlgorithm: the item in the slot of the front position is
+ * copied out & front is moved on.  the ring may then be shrunk.
+ * 
+ * returnValue: DataType item
+*/
+template <typename DataType>
+DataType QueueArray<DataType>::dequeue() throw (logic_error)
+{
+	if( isEmpty() )
+	{
+		throw logic_error( "dequeue() while queue empty" );
+	}
+
+	DataType item = dataItems[ front & ( maxSize - 1 ) ];
+
+	front++;
+	shrinkIfSparse();
+	return item;
+}
+
+/*
+ * name: clear
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: the queue is empty
+ * 
+ * functionAlgorithm: front & back are set to zero.  if shrinking is on
+ * the ring also goes back to its starting size.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueArray<DataType>::clear()
+{
+	front = back = 0;
+
+	if( shrink && maxSize > minSize )
+	{
+		try
+		{
+			resize( minSize );
+		}
+		catch( bad_alloc& )
+		{
+		}
+	}
+}
+
+/*
+ * name: isEmpty
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: front & back are equal when there are no items
+ * 
+ * returnValue: bool
+*/
+template <typename DataType>
+bool QueueArray<DataType>::isEmpty() const
+{
+	return ( front == back );
+}
+
+/*
+ * name: isFull
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: the ring grows as needed, so the queue is only full
+ * when the largest ring is full
+ * 
+ * returnValue: bool
+*/
+template <typename DataType>
+bool QueueArray<DataType>::isFull() const
+{
+	return ( int( back - front ) == MAX_SIZE );
+}
+
+/*
+ * name: putFront
+ * 
+ * inputParamter: a DataType item
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: the item is at the front of the queue
+ * 
+ * functionAlgorithm: the ring is doubled first if it is full, as in
+ * enqueue.  front is moved back one position & the item is stored in
+ * its slot.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueArray<DataType>::putFront( const DataType &item ) throw (logic_error)
+{
+	if( int( back - front ) == maxSize )
+	{
+		if( maxSize == MAX_SIZE )
+		{
+			throw logic_error( "putFront() while queue full" );
+		}
+
+		try
+		{
+			resize( maxSize * 2 );
+		}
+		catch( bad_alloc& )
+		{
+			throw logic_error( "putFront() while queue full" );
+		}
+	}
+
+	front--;
+	dataItems[ front & ( maxSize - 1 ) ] = item;
+}
+
+/*
+ * name: getRear
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: the queue must not be empty
+ * 
+ * postCondtion: the rear item is removed
+ * 
+ * functionAlgorithm: back is moved back one position & the item in its
+ * slot is copied out.  the ring may then be shrunk.
+ * 
+ * returnValue: DataType item
+*/
+template <typename DataType>
+DataType QueueArray<DataType>::getRear() throw (logic_error)
+{
+	if( isEmpty() )
+	{
+		throw logic_error( "getRear() while queue empty" );
+	}
+
+	back--;
+
+	DataType item = dataItems[ back & ( maxSize - 1 ) ];
+
+	shrinkIfSparse();
+	return item;
+}
+
+/*
+ * name: getLength
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: the positions are unsigned, so their difference is
+ * the number of items even after they wrap around
+ * 
+ * returnValue: int number of items
+*/
+template <typename DataType>
+int QueueArray<DataType>::getLength() const
+{
+	return int( back - front );
+}
+
+/*
+ * name: showStructure
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: outputs the slot of the front & back positions,
+ * then every slot of the ring with the items in the slots that hold
+ * one.  intended for testing and debugging purposes only.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueArray<DataType>::showStructure() const
+{
+	int j;
+	unsigned int mask = maxSize - 1;
+
+	if( isEmpty() )
+	{
+		cout << "Empty queue" << endl;
+	}
+	else
+	{
+		cout << "Front = " << ( front & mask ) << "  Back = "
+		     << ( ( back - 1 ) & mask ) << endl;
+
+		for( j = 0; j < maxSize; j++ )
+		{
+			cout << j << "\t";
+		}
+
+		cout << endl;
+
+		for( j = 0; j < maxSize; j++ )
+		{
+			if( ( ( j - front ) & mask ) < back - front )
+			{
+				cout << dataItems[ j ] << "\t";
+			}
+			else
+			{
+				cout << " \t";
+			}
+		}
+
+		cout << endl;
+	}
+}
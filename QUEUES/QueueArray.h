@@ -10,10 +10,18 @@ using namespace std;
 
 #include "Queue.h"
 
+// Queue kept in a ring of a power of two slots.  front and back are
+// positions that only ever move forward (or, for putFront, back), and
+// are turned into slots by masking with maxSize - 1.  A full ring is
+// replaced by one twice the size, with the items copied over in queue
+// order, so maxNumber is only the starting size.  When shrinkWhenSparse
+// is set, a ring that falls to a quarter full is halved again, but never
+// below the starting size.
 template <typename DataType>
-class QueueArray : public Queue<DataType> {
+class QueueArray {
   public:
-    QueueArray(int maxNumber = Queue<DataType>::MAX_QUEUE_SIZE);
+    QueueArray(int maxNumber = Queue<DataType>::MAX_QUEUE_SIZE,
+               bool shrinkWhenSparse = false);
     QueueArray(const QueueArray& other);
     QueueArray& operator=(const QueueArray& other);
     ~QueueArray();
@@ -33,9 +41,16 @@ class QueueArray : public Queue<DataType> {
     void showStructure() const;
 
   private:
-    int maxSize;
-    int front;
-    int back;
+    void resize(int newSize);
+    void shrinkIfSparse();
+
+    static const int MAX_SIZE = 1 << 30;   // Largest ring it will grow to
+
+    int maxSize;                   // Slots in the ring, a power of two
+    int minSize;                   // Starting size, never shrunk below
+    bool shrink;                   // Halve the ring when a quarter full
+    unsigned int front;            // Position of the front item
+    unsigned int back;             // Position after the rear item
     DataType* dataItems;
 };
 
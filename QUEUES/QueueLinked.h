@@ -8,7 +8,7 @@ using namespace std;
 #include "Queue.h"
 
 template <typename DataType>
-class QueueLinked : public Queue<DataType> {
+class QueueLinked {
   public:
     QueueLinked(int maxNumber = Queue<DataType>::MAX_QUEUE_SIZE);
     QueueLinked(const QueueLinked& other);
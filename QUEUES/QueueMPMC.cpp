@@ -0,0 +1,392 @@
+#include <iostream>
+#include "QueueMPMC.h"
+
+using namespace std;
+
+/*
+ * name: QueueMPMC
+ * 
+ * inputParamter: the least number of items the queue must hold
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: an empty queue will be created
+ * 
+ * functionAlgorithm: the slot count is maxNumber rounded up to a power
+ * of two, so that a position is turned into a slot by masking, and is at
+ * least two and no more than MAX_SIZE.  with one slot the sequence
+ * pos + 1 that marks it full for one lap is the same as the sequence
+ * that marks it free for the next, so a second enqueue would overwrite
+ * the first item.  slot i starts with sequence i, which makes it free
+ * for the enqueue at position i.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+QueueMPMC<DataType>::QueueMPMC( int maxNumber )
+	: enqueuePos( 0 ), dequeuePos( 0 )
+{
+	size_t wanted = ( maxNumber > 0 ) ? size_t( maxNumber ) : 0;
+
+	capacity = 2;
+
+	while( capacity < wanted && capacity < MAX_SIZE )
+	{
+		capacity *= 2;
+	}
+
+	cells = new Cell[ capacity ];
+
+	for( size_t i = 0; i < capacity; i++ )
+	{
+		cells[ i ].sequence.store( i, memory_order_relaxed );
+	}
+}
+
+/*
+ * name: ~QueueMPMC
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: no thread is using the queue
+ * 
+ * postCondtion: the ring will be deallocated
+ * 
+ * functionAlgorithm: the ring is deleted
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+QueueMPMC<DataType>::~QueueMPMC()
+{
+	delete[] cells;
+}
+
+/*
+ * name: tryEnqueue
+ * 
+ * inputParamter: a DataType item
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: if there was room the item is at the back of the queue
+ * 
+ * functionAlgorithm: the slot at enqueuePos is checked.  if its sequence
+ * equals the position the slot is free, and the thread tries to claim
+ * the position by moving enqueuePos on with a compare-and-swap; if
+ * another producer got there first the swap reloads the position and
+ * the thread tries again.  a sequence behind the position means the
+ * consumers have not emptied the slot since the last lap, so the queue
+ * is full.  a sequence ahead of it means another producer has already
+ * claimed it, so the position is reloaded.  once the position is
+ * claimed the item is copied in and the sequence is set to pos + 1 with
+ * release, which hands the slot to the consumer of that position.
+ * 
+ * returnValue: bool false if the queue was full
+*/
+template <typename DataType>
+bool QueueMPMC<DataType>::tryEnqueue( const DataType &item )
+{
+	Cell *cell;
+	size_t pos = enqueuePos.load( memory_order_relaxed );
+
+	for( ; ; )
+	{
+		cell = &cells[ pos & ( capacity - 1 ) ];
+
+		size_t seq = cell->sequence.load( memory_order_acquire );
+		ptrdiff_t diff = ptrdiff_t( seq ) - ptrdiff_t( pos );
+
+		if( diff == 0 )
+		{
+			if( enqueuePos.compare_exchange_weak( pos, pos + 1, memory_order_relaxed ) )
+			{
+				break;
+			}
+		}
+		else if( diff < 0 )
+		{
+			return false;
+		}
+		else
+		{
+			pos = enqueuePos.load( memory_order_relaxed );
+		}
+	}
+
+	cell->dataItem = item;
+	cell->sequence.store( pos + 1, memory_order_release );
+	return true;
+}
+
+/*
+ * name: tryDequeue
+ * 
+ * inputParamter: a DataType item passed by reference
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: if the queue had items the front one is removed and
+ * returned through item
+ * 
+ * functionAlgorithm: the mirror image of tryEnqueue.  the slot at
+ * dequeuePos holds an item once its sequence is pos + 1; a sequence
+ * behind that means the producer has not filled it, so the queue is
+ * empty.  after claiming the position the item is copied out and the
+ * sequence is set to pos + capacity, which frees the slot for the
+ * enqueue one lap later.
+ * 
+ * returnValue: bool false if the queue was empty
+*/
+template <typename DataType>
+bool QueueMPMC<DataType>::tryDequeue( DataType &item )
+{
+	Cell *cell;
+	size_t pos = dequeuePos.load( memory_order_relaxed );
+
+	for( ; ; )
+	{
+		cell = &cells[ pos & ( capacity - 1 ) ];
+
+		size_t seq = cell->sequence.load( memory_order_acquire );
+		ptrdiff_t diff = ptrdiff_t( seq ) - ptrdiff_t( pos + 1 );
+
+		if( diff == 0 )
+		{
+			if( dequeuePos.compare_exchange_weak( pos, pos + 1, memory_order_relaxed ) )
+			{
+				break;
+			}
+		}
+		else if( diff < 0 )
+		{
+			return false;
+		}
+		else
+		{
+			pos = dequeuePos.load( memory_order_relaxed );
+		}
+	}
+
+	item = cell->dataItem;
+	cell->sequence.store( pos + capacity, memory_order_release );
+	return true;
+}
+
+/*
+ * name: enqueue
+ * 
+ * inputParamter: a DataType item
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: the item is at the back of the queue
+ * 
+ * functionAlgorithm: calls tryEnqueue and throws if there is no room
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueMPMC<DataType>::enqueue( const DataType &item ) throw (logic_error)
+{
+	if( !tryEnqueue( item ) )
+	{
+		throw logic_error( "enqueue() while queue full" );
+	}
+}
+
+/*
+ * name: dequeue
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: the front item is removed
+ * 
+ * functionAlgorithm: calls tryDequeue and throws if there was no item
+ * 
+ * returnValue: DataType item
+*/
+template <typename DataType>
+DataType QueueMPMC<DataType>::dequeue() throw (logic_error)
+{
+	DataType item;
+
+	if( !tryDequeue( item ) )
+	{
+		throw logic_error( "dequeue() while queue empty" );
+	}
+
+	return item;
+}
+
+/*
+ * name: clear
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: the queue was empty at some point during the call
+ * 
+ * functionAlgorithm: items are dequeued and dropped until a dequeue
+ * finds the queue empty.  slots cannot be skipped wholesale as in the
+ * single consumer queue, since other consumers may be part way through
+ * copying out of them.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueMPMC<DataType>::clear()
+{
+	DataType item;
+
+	while( tryDequeue( item ) )
+	{
+	}
+}
+
+/*
+ * name: isEmpty
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: the positions are equal when there are no items
+ * 
+ * returnValue: bool
+*/
+template <typename DataType>
+bool QueueMPMC<DataType>::isEmpty() const
+{
+	return ( getLength() == 0 );
+}
+
+/*
+ * name: isFull
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: the positions are capacity apart when every slot
+ * is claimed
+ * 
+ * returnValue: bool
+*/
+template <typename DataType>
+bool QueueMPMC<DataType>::isFull() const
+{
+	return ( size_t( getLength() ) == capacity );
+}
+
+/*
+ * name: putFront
+ * 
+ * inputParamter: a DataType item
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: the front of the ring is claimed by consumers
+ * only, so an item cannot be added there without a lock.  always
+ * throws.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueMPMC<DataType>::putFront( const DataType& /* newDataItem */ ) throw (logic_error)
+{
+	throw logic_error( "putFront() is not supported by QueueMPMC" );
+}
+
+/*
+ * name: getRear
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: the back of the ring is claimed by producers
+ * only, so an item cannot be taken from there without a lock.  always
+ * throws.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+DataType QueueMPMC<DataType>::getRear() throw (logic_error)
+{
+	throw logic_error( "getRear() is not supported by QueueMPMC" );
+}
+
+/*
+ * name: getLength
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: dequeuePos is loaded before enqueuePos, so the
+ * difference is never negative.  consumers may have moved on between
+ * the two loads, so it is capped at capacity.  claimed slots whose
+ * copy has not finished are counted.
+ * 
+ * returnValue: int number of items
+*/
+template <typename DataType>
+int QueueMPMC<DataType>::getLength() const
+{
+	size_t front = dequeuePos.load( memory_order_acquire );
+	size_t length = enqueuePos.load( memory_order_acquire ) - front;
+
+	return int( length < capacity ? length : capacity );
+}
+
+/*
+ * name: showStructure
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: no thread is using the queue
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: outputs the items from front to back, marking the
+ * front one, as the linked queue does.  intended for testing and
+ * debugging purposes only.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueMPMC<DataType>::showStructure() const
+{
+	size_t front = dequeuePos.load();
+	size_t back = enqueuePos.load();
+
+	if( front == back )
+	{
+		cout << "Empty queue" << endl;
+	}
+	else
+	{
+		cout << "Front\t[" << cells[ front & ( capacity - 1 ) ].dataItem << "] ";
+
+		for( size_t i = front + 1; i != back; i++ )
+		{
+			cout << cells[ i & ( capacity - 1 ) ].dataItem << " ";
+		}
+
+		cout << "\trear" << endl;
+	}
+}
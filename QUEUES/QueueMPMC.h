@@ -0,0 +1,76 @@
+// QueueMPMC.h
+
+#ifndef QUEUEMPMC_H
+#define QUEUEMPMC_H
+
+#include <stdexcept>
+#include <iostream>
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+#include "Queue.h"
+
+// Bounded lock-free queue that any number of threads may enqueue into and
+// dequeue from at once (D. Vyukov's bounded MPMC queue).  Every slot of the
+// ring, which has a power of two slots, carries a sequence number saying
+// whose turn it is: a slot is free for the enqueue at position pos when its
+// sequence is pos, and holds an item for the dequeue at position pos when
+// its sequence is pos + 1.  A thread claims a position by compare-and-swap
+// on enqueuePos or dequeuePos, then copies its item and hands the slot on by
+// storing the next sequence number.  Producers and consumers only meet on a
+// slot, never on a shared counter, and the two counters are padded onto
+// cache lines of their own.
+//
+// isEmpty, isFull and getLength may be out of date by the time they return
+// if other threads are running.
+template <typename DataType>
+class QueueMPMC {
+  public:
+    QueueMPMC(int maxNumber = Queue<DataType>::MAX_QUEUE_SIZE);
+    ~QueueMPMC();
+
+    bool tryEnqueue(const DataType& newDataItem);  // False if full
+    bool tryDequeue(DataType& dataItem);           // False if empty
+
+    void enqueue(const DataType& newDataItem) throw (logic_error);
+    DataType dequeue() throw (logic_error);
+
+    void clear();
+
+    bool isEmpty() const;
+    bool isFull() const;
+
+    void putFront(const DataType& newDataItem) throw (logic_error);
+    DataType getRear() throw (logic_error);
+    int getLength() const;
+
+    void showStructure() const;
+
+  private:
+    QueueMPMC(const QueueMPMC& other);             // Not copyable
+    QueueMPMC& operator=(const QueueMPMC& other);
+
+    static const int CACHE_LINE = 64;
+    static const size_t MAX_SIZE = size_t(1) << 30;   // Largest ring
+
+    class Cell {
+      public:
+	atomic<size_t> sequence;   // pos when free, pos + 1 when full
+	DataType dataItem;
+    };
+
+    size_t capacity;               // Slots in the ring, a power of two
+                                   //   no less than 2
+    Cell* cells;
+    char padding0[CACHE_LINE];
+
+    atomic<size_t> enqueuePos;     // Next position to enqueue into
+    char padding1[CACHE_LINE];
+
+    atomic<size_t> dequeuePos;     // Next position to dequeue from
+    char padding2[CACHE_LINE];
+};
+
+#endif
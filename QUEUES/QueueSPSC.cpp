@@ -0,0 +1,340 @@
+#include <iostream>
+#include "QueueSPSC.h"
+
+using namespace std;
+
+/*
+ * name: QueueSPSC
+ * 
+ * inputParamter: the least number of items the queue must hold
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: an empty queue will be created
+ * 
+ * functionAlgorithm: the slot count is maxNumber rounded up to a power
+ * of two, so that a counter is turned into a slot by masking instead of
+ * by a division, but is no more than MAX_SIZE.  both counters start at
+ * zero, as do the copies each thread keeps of the other's counter.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+QueueSPSC<DataType>::QueueSPSC( int maxNumber )
+	: head( 0 ), tail( 0 )
+{
+	size_t wanted = ( maxNumber > 0 ) ? size_t( maxNumber ) : 0;
+
+	capacity = 1;
+
+	while( capacity < wanted && capacity < MAX_SIZE )
+	{
+		capacity *= 2;
+	}
+
+	dataItems = new DataType[ capacity ];
+	cachedTail = 0;
+	cachedHead = 0;
+}
+
+/*
+ * name: ~QueueSPSC
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: neither thread is using the queue
+ * 
+ * postCondtion: the ring will be deallocated
+ * 
+ * functionAlgorithm: the ring is deleted
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+QueueSPSC<DataType>::~QueueSPSC()
+{
+	delete[] dataItems;
+}
+
+/*
+ * name: tryEnqueue
+ * 
+ * inputParamter: a DataType item
+ * 
+ * preCondtion: called by the producer thread
+ * 
+ * postCondtion: if there was room the item is at the back of the queue
+ * 
+ * functionAlgorithm: the producer owns tail, so it reads it relaxed.  it
+ * checks for room against its copy of head, and only if the ring looks
+ * full loads the real head, with acquire so that the consumer is done
+ * reading the slots it has given back.  the item is written into its
+ * slot before tail is moved on with release, which is what lets the
+ * consumer see the item once it sees the new tail.
+ * 
+ * returnValue: bool false if the queue was full
+*/
+template <typename DataType>
+bool QueueSPSC<DataType>::tryEnqueue( const DataType &item )
+{
+	size_t back = tail.load( memory_order_relaxed );
+
+	if( back - cachedHead == capacity )
+	{
+		cachedHead = head.load( memory_order_acquire );
+
+		if( back - cachedHead == capacity )
+		{
+			return false;
+		}
+	}
+
+	dataItems[ back & ( capacity - 1 ) ] = item;
+	tail.store( back + 1, memory_order_release );
+	return true;
+}
+
+/*
+ * name: tryDequeue
+ * 
+ * inputParamter: a DataType item passed by reference
+ * 
+ * preCondtion: called by the consumer thread
+ * 
+ * postCondtion: if the queue had items the front one is removed and
+ * returned through item
+ * 
+ * functionAlgorithm: the mirror image of tryEnqueue.  the consumer checks
+ * its copy of tail, reloads tail with acquire only when the ring looks
+ * empty, copies the item out and then moves head on with release, which
+ * gives the slot back to the producer.
+ * 
+ * returnValue: bool false if the queue was empty
+*/
+template <typename DataType>
+bool QueueSPSC<DataType>::tryDequeue( DataType &item )
+{
+	size_t front = head.load( memory_order_relaxed );
+
+	if( front == cachedTail )
+	{
+		cachedTail = tail.load( memory_order_acquire );
+
+		if( front == cachedTail )
+		{
+			return false;
+		}
+	}
+
+	item = dataItems[ front & ( capacity - 1 ) ];
+	head.store( front + 1, memory_order_release );
+	return true;
+}
+
+/*
+ * name: enqueue
+ * 
+ * inputParamter: a DataType item
+ * 
+ * preCondtion: called by the producer thread
+ * 
+ * postCondtion: the item is at the back of the queue
+ * 
+ * functionAlgorithm: calls tryEnqueue and throws if there is no room
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueSPSC<DataType>::enqueue( const DataType &item ) throw (logic_error)
+{
+	if( !tryEnqueue( item ) )
+	{
+		throw logic_error( "enqueue() while queue full" );
+	}
+}
+
+/*
+ * name: dequeue
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: called by the consumer thread
+ * 
+ * postCondtion: the front item is removed
+ * 
+ * functionAlgorithm: calls tryDequeue and throws if there was no item
+ * 
+ * returnValue: DataType item
+*/
+template <typename DataType>
+DataType QueueSPSC<DataType>::dequeue() throw (logic_error)
+{
+	DataType item;
+
+	if( !tryDequeue( item ) )
+	{
+		throw logic_error( "dequeue() while queue empty" );
+	}
+
+	return item;
+}
+
+/*
+ * name: clear
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: called by the consumer thread
+ * 
+ * postCondtion: every item enqueued before the call has been dropped
+ * 
+ * functionAlgorithm: head is moved up to the tail the consumer can see,
+ * which gives all of those slots back to the producer at once
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueSPSC<DataType>::clear()
+{
+	cachedTail = tail.load( memory_order_acquire );
+	head.store( cachedTail, memory_order_release );
+}
+
+/*
+ * name: isEmpty
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: the counters are equal when there are no items
+ * 
+ * returnValue: bool
+*/
+template <typename DataType>
+bool QueueSPSC<DataType>::isEmpty() const
+{
+	return ( getLength() == 0 );
+}
+
+/*
+ * name: isFull
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: the counters are capacity apart when every slot is
+ * in use
+ * 
+ * returnValue: bool
+*/
+template <typename DataType>
+bool QueueSPSC<DataType>::isFull() const
+{
+	return ( size_t( getLength() ) == capacity );
+}
+
+/*
+ * name: putFront
+ * 
+ * inputParamter: a DataType item
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: the front of the ring belongs to the consumer, so
+ * the producer cannot add there without a lock.  always throws.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueSPSC<DataType>::putFront( const DataType& /* newDataItem */ ) throw (logic_error)
+{
+	throw logic_error( "putFront() is not supported by QueueSPSC" );
+}
+
+/*
+ * name: getRear
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: the back of the ring belongs to the producer, so
+ * the consumer cannot take from there without a lock.  always throws.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+DataType QueueSPSC<DataType>::getRear() throw (logic_error)
+{
+	throw logic_error( "getRear() is not supported by QueueSPSC" );
+}
+
+/*
+ * name: getLength
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: none
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: head is loaded before tail, so tail is never older
+ * than head and the difference is never negative
+ * 
+ * returnValue: int number of items
+*/
+template <typename DataType>
+int QueueSPSC<DataType>::getLength() const
+{
+	size_t front = head.load( memory_order_acquire );
+
+	return int( tail.load( memory_order_acquire ) - front );
+}
+
+/*
+ * name: showStructure
+ * 
+ * inputParamter: none
+ * 
+ * preCondtion: neither thread is using the queue
+ * 
+ * postCondtion: none
+ * 
+ * functionAlgorithm: outputs the items from front to back, marking the
+ * front one, as the linked queue does.  intended for testing and
+ * debugging purposes only.
+ * 
+ * returnValue: none
+*/
+template <typename DataType>
+void QueueSPSC<DataType>::showStructure() const
+{
+	size_t front = head.load();
+	size_t back = tail.load();
+
+	if( front == back )
+	{
+		cout << "Empty queue" << endl;
+	}
+	else
+	{
+		cout << "Front\t[" << dataItems[ front & ( capacity - 1 ) ] << "] ";
+
+		for( size_t i = front + 1; i != back; i++ )
+		{
+			cout << dataItems[ i & ( capacity - 1 ) ] << " ";
+		}
+
+		cout << "\trear" << endl;
+	}
+}
@@ -0,0 +1,69 @@
+// QueueSPSC.h
+
+#ifndef QUEUESPSC_H
+#define QUEUESPSC_H
+
+#include <stdexcept>
+#include <iostream>
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+#include "Queue.h"
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread.  The items live in a ring of a power of two slots, indexed by
+// masking counters that only ever grow.  The producer alone writes tail and
+// the consumer alone writes head, so neither needs a read-modify-write; each
+// keeps a private copy of the other's counter and only reloads it when the
+// ring looks full or empty.  The counters are padded onto cache lines of
+// their own so that the two threads do not fight over one line.
+//
+// enqueue and putFront may only be called by the producer; dequeue, getRear
+// and clear only by the consumer.  isEmpty, isFull and getLength may be out
+// of date by the time they return if the other thread is running.
+template <typename DataType>
+class QueueSPSC {
+  public:
+    QueueSPSC(int maxNumber = Queue<DataType>::MAX_QUEUE_SIZE);
+    ~QueueSPSC();
+
+    bool tryEnqueue(const DataType& newDataItem);  // False if full
+    bool tryDequeue(DataType& dataItem);           // False if empty
+
+    void enqueue(const DataType& newDataItem) throw (logic_error);
+    DataType dequeue() throw (logic_error);
+
+    void clear();
+
+    bool isEmpty() const;
+    bool isFull() const;
+
+    void putFront(const DataType& newDataItem) throw (logic_error);
+    DataType getRear() throw (logic_error);
+    int getLength() const;
+
+    void showStructure() const;
+
+  private:
+    QueueSPSC(const QueueSPSC& other);             // Not copyable
+    QueueSPSC& operator=(const QueueSPSC& other);
+
+    static const int CACHE_LINE = 64;
+    static const size_t MAX_SIZE = size_t(1) << 30;   // Largest ring
+
+    size_t capacity;               // Slots in the ring, a power of two
+    DataType* dataItems;
+    char padding0[CACHE_LINE];
+
+    atomic<size_t> head;           // Next item to dequeue
+    size_t cachedTail;             // Consumer's copy of tail
+    char padding1[CACHE_LINE];
+
+    atomic<size_t> tail;           // Next slot to enqueue into
+    size_t cachedHead;             // Producer's copy of head
+    char padding2[CACHE_LINE];
+};
+
+#endif
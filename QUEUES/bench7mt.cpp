@@ -0,0 +1,166 @@
+//--------------------------------------------------------------------
+//
+//  Laboratory 7                                         bench7mt.cpp
+//
+//  Hand-off benchmark for the lock-free queues.  Producer threads pass
+//  integers to consumer threads through a QueueSPSC (one of each), a
+//  QueueMPMC, and a QueueLinked guarded by a mutex, for 1 to N pairs of
+//  threads (N is the number of cores), and then through the smallest
+//  rings the queues allow.  Every run checks that each item came out
+//  exactly once; a rate of -1 means one did not.
+//
+//  Build:  g++ -O2 -std=c++11 -pthread bench7mt.cpp -o bench7mt
+//  Usage:  bench7mt [items per producer]
+//          The default is 1000000 items.
+//
+//--------------------------------------------------------------------
+
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include "QueueLinked.cpp"
+#include "QueueSPSC.cpp"
+#include "QueueMPMC.cpp"
+
+using namespace std;
+
+const int ringSize = 1024;
+
+// QueueLinked with every operation made under one mutex.
+class LockedQueue
+{
+  public:
+    bool tryEnqueue ( const long& newDataItem )
+        { lock_guard<mutex> guard( lock ); queue.enqueue( newDataItem ); return true; }
+    bool tryDequeue ( long& dataItem )
+    {
+        lock_guard<mutex> guard( lock );
+        if ( queue.isEmpty() )
+            return false;
+        dataItem = queue.dequeue();
+        return true;
+    }
+
+  private:
+    mutex lock;
+    QueueLinked<long> queue;
+};
+
+//--------------------------------------------------------------------
+
+template < typename Hand >
+void producer ( Hand& queue, int first, int items )
+{
+    for ( long item = first; item < first + items; item++ )
+        while ( !queue.tryEnqueue( item ) )
+            this_thread::yield();
+}
+
+template < typename Hand >
+void consumer ( Hand& queue, atomic<long>& remaining, long& sum )
+{
+    long item;
+
+    sum = 0;
+
+    while ( remaining.load( memory_order_relaxed ) > 0 )
+    {
+        if ( queue.tryDequeue( item ) )
+        {
+            sum += item;
+            remaining.fetch_sub( 1, memory_order_relaxed );
+        }
+        else
+            this_thread::yield();
+    }
+}
+
+// Runs pairs producers and pairs consumers, and returns the items
+// handed off per second in millions, or -1 if the items that came out
+// do not add up to the items that went in.
+template < typename Hand >
+double run ( Hand& queue, unsigned int pairs, int items )
+{
+    vector<thread> pool;
+    vector<long> sums( pairs );
+    long total = long( pairs ) * items;
+    atomic<long> remaining( total );
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for ( unsigned int t = 0; t < pairs; t++ )
+    {
+        pool.push_back( thread( producer<Hand>, ref( queue ), t * items, items ) );
+        pool.push_back( thread( consumer<Hand>, ref( queue ), ref( remaining ),
+                                ref( sums[t] ) ) );
+    }
+    for ( unsigned int t = 0; t < pool.size(); t++ )
+        pool[t].join();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    long sum = 0;
+    for ( unsigned int t = 0; t < pairs; t++ )
+        sum += sums[t];
+    if ( sum != total * ( total - 1 ) / 2 )
+        return -1;
+
+    return total / elapsed.count() / 1e6;
+}
+
+int main ( int argc, char **argv )
+{
+    int items = ( argc > 1 ) ? atoi( argv[1] ) : 1000000;
+
+    if ( items <= 0 )
+    {
+        cout << "Item count must be positive" << endl;
+        return 1;
+    }
+
+    unsigned int cores = thread::hardware_concurrency();
+    if ( cores == 0 )
+        cores = 1;
+
+    cout << items << " items per producer, " << ringSize << " slot rings"
+         << endl;
+
+    QueueSPSC<long> spsc( ringSize );
+    cout << "SPSC, 1 pair: " << fixed << setprecision(2)
+         << run( spsc, 1, items ) << " Mitems/s" << endl;
+
+    cout << setw(8) << "pairs" << setw(16) << "MPMC Mitems/s"
+         << setw(17) << "mutex Mitems/s" << endl;
+
+    for ( unsigned int pairs = 1; pairs <= cores;
+          pairs = ( pairs * 2 > cores && pairs < cores ) ? cores : pairs * 2 )
+    {
+        QueueMPMC<long> mpmc( ringSize );
+        LockedQueue locked;
+
+        double mpmcRate = run( mpmc, pairs, items );
+        double lockedRate = run( locked, pairs, items );
+
+        cout << setw(8) << pairs << setw(16) << mpmcRate
+             << setw(17) << lockedRate << endl;
+    }
+
+    // The smallest rings the queues allow, where producers and consumers
+    // meet on every item.
+    int fewItems = items / 10 + 1;
+    QueueSPSC<long> tinySpsc( 1 );
+    QueueMPMC<long> tinyMpmc( 1 );
+
+    cout << "Smallest rings, " << fewItems << " items per producer" << endl;
+    cout << "SPSC, 1 pair: " << run( tinySpsc, 1, fewItems )
+         << " Mitems/s" << endl;
+    cout << "MPMC, 2 pairs: " << run( tinyMpmc, 2, fewItems )
+         << " Mitems/s" << endl;
+
+    return 0;
+}
@@ -17,6 +17,7 @@ using namespace std;
 #else
 #   include "QueueArray.cpp"
 #endif
+#include "QueueAdapter.h"
 
 //--------------------------------------------------------------------
 
@@ -120,11 +121,11 @@ int main()
 {
 #if !LAB7_TEST1
     cout << "Testing array implementation" << endl;
-    QueueArray<char> s1;
+    QueueAdapter<char, QueueArray> s1;
     test_queue(s1);
 #else
     cout << "Testing linked implementation" << endl;
-    QueueLinked<char> s2;
+    QueueAdapter<char, QueueLinked> s2;
     test_queue(s2);
 #endif
 